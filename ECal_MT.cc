@@ -12,6 +12,7 @@
 #include "DetectorConstruction.hh"
 #include "ActionInitialization.hh"
 #include "PhysicsList.hh"
+#include "EventSeeder.hh"
 
 #ifdef G4MULTITHREADED
 #include "G4MTRunManager.hh"
@@ -20,6 +21,7 @@
 #endif
 #include "QGSP_BIC_HP.hh"
 #include "G4UImanager.hh"
+#include "G4StateManager.hh"
 #include "QBBC.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
@@ -37,8 +39,10 @@
  * @param	PhysList 	Command line argument for Hadronic physics list
  * @param	Particle	Command line argument for type of Particle
  * @param	fiber		Command line argument for number of fibers in ECal
- * @param   CutEx       Command line argument for cut of deexcitation
+ * @param   CutEx       Command line argument for preset of production cuts and deexcitation (0-3)
  * @param   RootFile    Command line argument for name of ROOT file for results
+ * @param   Macro       Optional command line argument, macro executed before the run (e.g. /ECal/output/steps false)
+ * @param   Seed        Optional command line argument after the macro, master seed of the event seeds (default: time)
  * 
  **/
 
@@ -54,7 +58,9 @@ int main(int argc,char** argv)
   G4String PhysList="QGSP_BERT";
   G4String Particle="gamma";
   
-  if (argc==8)
+  G4long seed = time(NULL);
+
+  if (argc==8 || argc==9 || argc==10)
   {  
     NoE=atoi(argv[1]);
     Energy=atof(argv[2]);
@@ -63,11 +69,11 @@ int main(int argc,char** argv)
       fiber=atoi(argv[5]);
     CutEx=atoi(argv[6]);
     nThreads=atoi(argv[7]);
+    if (argc==10) { seed=atol(argv[9]); }
   }
 
   G4Random::setTheEngine(new CLHEP::RanecuEngine);
 
-  G4long seed = time(NULL);
   CLHEP::HepRandom::setTheSeed(seed);
 
 #ifdef G4MULTITHREADED
@@ -79,18 +85,29 @@ int main(int argc,char** argv)
   G4RunManager* runManager = new G4RunManager;
 #endif
   
-  runManager->SetUserInitialization(new DetectorConstruction(fiber));
+  DetectorConstruction* detector = new DetectorConstruction(fiber);
+  runManager->SetUserInitialization(detector);
   runManager->SetUserInitialization(new PhysicsList(PhysList,CutEx));
   runManager->SetUserInitialization(new ActionInitialization(Energy, Particle, fiber));
+  EventSeeder::Instance()->SetSeed(seed); /// made by the master run action, /ECal/random/seed overrides it
 
   G4VisManager* visManager = new G4VisExecutive;
   visManager->Initialize();
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
 
-  if (argc==8)
+  if (argc==8 || argc==9 || argc==10)
   {   
     /// batch
-   runManager->Initialize();
+   if (argc>=9)
+   {
+     UImanager->ApplyCommand(G4String("/control/execute ")+argv[8]);
+   }
+   if (G4StateManager::GetStateManager()->GetCurrentState()==G4State_PreInit)
+   {
+     runManager->Initialize(); /// unless the macro has done it
+   }
+   /// full optical tracking once, later runs of the same fiber load the cache file
+   detector->FillFiberLightTable();
    runManager->BeamOn(NoE);
    
   }
@@ -105,6 +122,10 @@ int main(int argc,char** argv)
     }
     
     UImanager->ApplyCommand("/control/execute gui.mac");
+    if (G4StateManager::GetStateManager()->GetCurrentState()==G4State_Idle)
+    {
+      detector->FillFiberLightTable(); /// table transport set by gui.mac, before any run of the session
+    }
     ui->SessionStart();
     delete ui;
   }
@@ -6,7 +6,9 @@
  * @section DESCRIPTION
  * 
  * The Geant4 simulation of ECal's ROOT macro.
- * Creating .root file from raw datas and Edep and Lateral histos. 
+ * Creating .root file from the columnar step file (steps.col) and Edep and Lateral histos.
+ * Edep and Lateral histos are taken from the profiles of the run (profiles.dat) if it exists
+ * and belongs to the same run as steps.col (same seed, first event index and events). 
  * Latest updates of project can be found in README file.
  **/
 
@@ -14,6 +16,8 @@
 #include <string>
 #include <fstream>
 #include <cmath>
+#include <cstdio>
+#include <vector>
 
 #include "TROOT.h"
 #include "TF1.h"
@@ -26,28 +30,113 @@
 #include "TMath.h"
 #include "TCanvas.h"
 
+#include "StepColumns.hh"
+
 using namespace std;
 
+/// Reads the three name lists of the dictionary, false if they run past its end
+static bool ReadDictionary(const StepColumnView& in, vector<string> names[3])
+{
+	const char* dictionary=in.GetDictionary();
+	const char* end=dictionary+in.GetHeader()->dictionarySize;
+	for(int list=0;list<3;list++)
+	{
+		unsigned int count=0;
+		if(end-dictionary<(long)sizeof(count)) { return false; }
+		memcpy(&count,dictionary,sizeof(count)); dictionary+=sizeof(count);
+		names[list].resize(count);
+		for(unsigned int i=0;i<count;i++)
+		{
+			unsigned int length=0;
+			if(end-dictionary<(long)sizeof(length)) { return false; }
+			memcpy(&length,dictionary,sizeof(length)); dictionary+=sizeof(length);
+			if((unsigned long)(end-dictionary)<length) { return false; }
+			names[list][i].assign(dictionary,length); dictionary+=length;
+		}
+	}
+	return true;
+}
+
+/// True if every index of the column points into the name list
+static bool InRange(const Int_t* column, ULong64_t n, const vector<string>& names)
+{
+	for(ULong64_t i=0;i<n;i++)
+	{
+		if(column[i]<0 || (size_t)column[i]>=names.size()) { return false; }
+	}
+	return true;
+}
+
 void Macro(Double_t fiber, const char ads[], const char adsX[], const char adsY[]){
 	
 	gStyle->SetOptStat(0);
 	gStyle->SetOptTitle(0);
 	
-	string name1,name2, particleName, procN, preName, postName;
-	char jel;
-	Double_t prekinE, preX, preY, preZ, postX, postY, postZ, postTime, edep;
+	string particleName, procN, preName, postName;
+	Double_t preX, preY, preZ, postX, postY, postZ, postTime, edep;
 	Int_t trackID,eID;
 	
 	Int_t osztas=30;
-	Double_t minZ=0.0,maxZ=10.512;
+	Double_t minZ=0.0,maxZ=10.512,zOffset=11.5;
 	Double_t l=(0.1*(fiber+1))/2;
 	Int_t counter=0;
 	
-	auto f = TFile::Open(ads,"RECREATE");
+	/// the step file is checked before the .root file is recreated, a bad file leaves it untouched
+	StepColumnView in1;
+	bool steps=in1.Open("steps.col");
+	if(!steps && ifstream("steps.col"))
+	{
+		cerr<<"Macro: steps.col is truncated or not a columnar step file, nothing is written"<<endl;
+		return;
+	}
+	const StepColumnHeader* header=steps ? in1.GetHeader() : 0;
+	
+	vector<string> names[3]; /// particles, processes, volumes
+	const Int_t *cEvent=0, *cTrack=0, *cParticle=0, *cProcess=0, *cPre=0, *cPost=0;
+	const Float_t *cEdep=0, *cPreX=0, *cPreY=0, *cPreZ=0, *cPostX=0, *cPostY=0, *cPostZ=0, *cTime=0;
+	if(steps)
+	{
+		if(!ReadDictionary(in1,names))
+		{
+			cerr<<"Macro: the dictionary of steps.col is corrupt, nothing is written"<<endl;
+			return;
+		}
+		cEvent=in1.GetColumn<Int_t>("eventID");
+		cTrack=in1.GetColumn<Int_t>("trackID");
+		cParticle=in1.GetColumn<Int_t>("particle");
+		cProcess=in1.GetColumn<Int_t>("process");
+		cPre=in1.GetColumn<Int_t>("preVolume");
+		cPost=in1.GetColumn<Int_t>("postVolume");
+		cEdep=in1.GetColumn<Float_t>("edep");
+		cPreX=in1.GetColumn<Float_t>("preX");
+		cPreY=in1.GetColumn<Float_t>("preY");
+		cPreZ=in1.GetColumn<Float_t>("preZ");
+		cPostX=in1.GetColumn<Float_t>("postX");
+		cPostY=in1.GetColumn<Float_t>("postY");
+		cPostZ=in1.GetColumn<Float_t>("postZ");
+		cTime=in1.GetColumn<Float_t>("postTime");
+		if(!cEvent || !cTrack || !cParticle || !cProcess || !cPre || !cPost || !cEdep ||
+		   !cPreX || !cPreY || !cPreZ || !cPostX || !cPostY || !cPostZ || !cTime)
+		{
+			cerr<<"Macro: steps.col misses a column, nothing is written"<<endl;
+			return;
+		}
+		if(!InRange(cParticle,header->nRecords,names[0]) || !InRange(cProcess,header->nRecords,names[1]) ||
+		   !InRange(cPre,header->nRecords,names[2]) || !InRange(cPost,header->nRecords,names[2]))
+		{
+			cerr<<"Macro: steps.col has a name index outside its dictionary, nothing is written"<<endl;
+			return;
+		}
+		
+		/// geometry of the run is taken from the file header
+		maxZ=header->maxZ;
+		zOffset=header->zOffset;
+		l=(header->fiberPitch*(header->nFiber+1))/2;
+	}
 	
-	ifstream in1("data.txt");
+	auto f = TFile::Open(ads,"RECREATE");
 	
-	TTree *tree = new TTree("T","Data from text file");
+	TTree *tree = new TTree("T","Data from columnar step file");
 	TCanvas  * cX = new TCanvas("Canvas","Results",1024,768);
 	auto h0 = new TH1D("TH1D0", "Leadott energia", osztas, minZ, maxZ);
 	auto h1 = new TH2D("TH2D1", "Lateral", osztas*5, -l, l, osztas*5, -l, l);
@@ -67,19 +156,69 @@ void Macro(Double_t fiber, const char ads[], const char adsX[], const char adsY[
 	tree->Branch("postName",&postName);
 	tree->Branch("postTime",&postTime,"postTime/D");
 	
-	while(!in1.eof())
+	bool online=false; /// histograms filled during the run, same binning
+	ifstream profiles("profiles.dat");
+	if(profiles)
+	{
+		string tag;
+		Int_t n;
+		Double_t lo, hi, value;
+		Long64_t seed=0, firstEvent=0, runEvents=0;
+		profiles>>tag;
+		if(tag=="run") { profiles>>seed>>firstEvent>>runEvents>>tag; }
+		else { tag.clear(); } /// profiles of an older version, the run cannot be identified
+		
+		/// the profiles must belong to the run of the step file
+		if(steps && (tag.empty() || header->seed!=seed || header->firstEvent!=firstEvent || header->runEvents!=runEvents))
+		{
+			cerr<<"Macro: profiles.dat is not from the run of steps.col, the histograms are filled from the steps"<<endl;
+			profiles.setstate(ios::failbit);
+		}
+		if(tag.empty()) { profiles>>tag; }
+		profiles>>n>>lo>>hi;
+		for(int i=1;i<=n;i++) { profiles>>value; h0->SetBinContent(i,value); }
+		profiles>>tag>>n>>lo>>hi;
+		for(int j=1;j<=n;j++)
+		{
+			for(int i=1;i<=n;i++) { profiles>>value; h1->SetBinContent(i,j,value); }
+		}
+		online=!profiles.fail();
+		if(!online) { h0->Reset(); h1->Reset(); }
+	}
+	
+	if(steps)
 	{
-		in1>>name2>>jel>>name1>>particleName>>procN>>trackID>>edep>>eID>>preX>>preY>>preZ>>postX>>postY>>postZ>>preName>>postName>>postTime;
-		h0->Fill(postZ-11.5, edep);
-		h1->Fill(postX, postY, edep);
-		if(postName=="Detector")
+		/// histograms need only three columns, no record is copied
+		for(ULong64_t i=0;i<header->nRecords && !online;i++)
 		{
-			counter++;
+			h0->Fill(cPostZ[i]-zOffset, cEdep[i]);
+			h1->Fill(cPostX[i], cPostY[i], cEdep[i]);
 		}
-		tree->Fill();
+		
+		/// the tree is filled event by event through the index
+		const StepEventIndex* events=in1.GetEvents();
+		for(ULong64_t e=0;e<header->nEvents;e++)
+		{
+			for(ULong64_t i=events[e].first;i<events[e].first+events[e].count;i++)
+			{
+				particleName=names[0][cParticle[i]]; procN=names[1][cProcess[i]]; trackID=cTrack[i]; eID=cEvent[i];
+				preX=cPreX[i]; preY=cPreY[i]; preZ=cPreZ[i];
+				postX=cPostX[i]; postY=cPostY[i]; postZ=cPostZ[i];
+				edep=cEdep[i]; postTime=cTime[i];
+				preName=names[2][cPre[i]];
+				postName=names[2][cPost[i]];
+				tree->Fill();
+			}
+		}
+	}
+	
+	ifstream photons("photons.dat"); /// detected photons per event, counted during the run
+	Int_t photonEvent, photonCount;
+	while(photons>>photonEvent>>photonCount)
+	{
+		counter+=photonCount;
 	}
 	tree->Print();
-	in1.close();
 	f->Write();
 	
 	Double_t x0[osztas], y0[osztas];
@@ -0,0 +1,40 @@
+#!/bin/bash
+#
+# Version: 1.0
+#
+# Script for comparing the production cuts of the tungsten (Absorber region) of Ecal,
+# the fibers keep a fine cut: CPU time per event against the change of the sampling fraction
+# Usage (in ecal_build): [SEED=n] ../benchmark_cuts.sh [events] [energy_GeV] [fiber_cut_mm] [absorber_cuts_mm...]
+# every cut runs the same events (master seed SEED, 12345 by default)
+
+EVENTS=${1:-200}
+ENERGY=${2:-10}
+FIBERCUT=${3:-0.1}
+shift $(( $# < 3 ? $# : 3 ))
+CUTS=${@:-0.1 0.3 0.7 1 2 5}
+SEED=${SEED:-12345}
+RESULT=cuts_benchmark.txt
+
+echo "# absorber_mm fibers_mm cpu_ms_per_event sampling_fraction speedup sampling_change_%" > $RESULT
+for cut in $CUTS; do
+  cat > benchmark_cuts.mac <<MACRO
+/ECal/output/steps false
+/ECal/output/channels false
+/ECal/cuts/absorber $cut mm
+/ECal/cuts/fibers $FIBERCUT mm
+/ECal/cuts/photodetector $FIBERCUT mm
+/run/initialize
+MACRO
+  ./ECal_MT $EVENTS $ENERGY QGSP_BERT e- 10 3 1 benchmark_cuts.mac $SEED > benchmark_cuts_$cut.log 2>&1
+  line=$(grep " Sampling fraction: " benchmark_cuts_$cut.log | tail -1)
+  fraction=$(echo "$line" | awk '{print $3}')
+  cpu=$(echo "$line" | sed 's/.*, \([0-9.e+-]*\) ms per event.*/\1/')
+  echo "$cut $FIBERCUT $cpu $fraction" | tee -a $RESULT
+done
+rm -f benchmark_cuts.mac
+
+## relative to the finest absorber cut (first row)
+awk '/^#/ {print; next} !ref {ref=$3; frac=$4}
+     {printf "%s %s %s %s %.2f %.2f\n", $1, $2, $3, $4, ref/$3, 100*($4-frac)/frac}' $RESULT > $RESULT.tmp
+mv $RESULT.tmp $RESULT
+echo Benchmark complete, results in $RESULT.
@@ -0,0 +1,30 @@
+#!/bin/bash
+#
+# Version: 1.0
+#
+# Script for comparing the fiber grid layouts (placement, replica, parameterised) of Ecal
+# Usage (in ecal_build): ../benchmark_geometry.sh [points] [fibers...]
+
+POINTS=${1:-100000}
+shift
+FIBERS=${@:-2 5 10 20 30 40 50 60}
+RESULT=geometry_benchmark.txt
+
+echo "# layout fibers construct_s volumes close_s close_MB rss_MB locate_us step_us" > $RESULT
+for fiber in $FIBERS; do
+  for layout in placement replica parameterised; do
+    cat > benchmark_$layout.mac <<MACRO
+/ECal/output/steps false
+/ECal/output/channels false
+/ECal/geometry/fiberPlacement $layout
+/run/initialize
+/ECal/geometry/benchmark $POINTS
+MACRO
+    ./ECal_MT 0 1 QGSP_BERT gamma $fiber 0 1 benchmark_$layout.mac > benchmark_$layout.log 2>&1
+    construct=$(grep " Geometry (" benchmark_$layout.log | sed 's/.*, \([0-9]*\) physical volumes, constructed in \([0-9.e-]*\) s.*/\2 \1/')
+    bench=$(grep " GeometryBenchmark " benchmark_$layout.log | awk '{print $6, $8, $10, $12, $14}')
+    echo "$layout $fiber $construct $bench" | tee -a $RESULT
+  done
+done
+rm -f benchmark_*.mac
+echo Benchmark complete, results in $RESULT.
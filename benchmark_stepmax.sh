@@ -0,0 +1,37 @@
+#!/bin/bash
+#
+# Version: 1.0
+#
+# Script for measuring the cost of the step limitation (StepMax) of Ecal: the former setup
+# (registered for every charged particle without limit) against no StepMax and limits of the fibers
+# Usage (in ecal_build): ../benchmark_stepmax.sh [events] [energy_GeV] [step_mm] [seed]
+# every setup runs the same events (master seed, 12345 by default)
+
+EVENTS=${1:-200}
+ENERGY=${2:-10}
+STEP=${3:-0.1}
+SEED=${4:-12345}
+RESULT=stepmax_benchmark.txt
+
+declare -A SETUPS
+SETUPS[former]="/ECal/stepMax/everywhere true"
+SETUPS[none]=""
+SETUPS[fibers]="/ECal/stepMax/region Fibers $STEP mm"
+SETUPS[cores]="/ECal/stepMax/volume fiberInterior $STEP mm"
+
+echo "# setup cpu_ms_per_event sampling_fraction" > $RESULT
+for setup in former none fibers cores; do
+  cat > benchmark_stepmax.mac <<MACRO
+/ECal/output/steps false
+/ECal/output/channels false
+${SETUPS[$setup]}
+/run/initialize
+MACRO
+  ./ECal_MT $EVENTS $ENERGY QGSP_BERT e- 10 3 1 benchmark_stepmax.mac $SEED > benchmark_stepmax_$setup.log 2>&1
+  line=$(grep " Sampling fraction: " benchmark_stepmax_$setup.log | tail -1)
+  fraction=$(echo "$line" | awk '{print $3}')
+  cpu=$(echo "$line" | sed 's/.*, \([0-9.e+-]*\) ms per event.*/\1/')
+  echo "$setup $cpu $fraction" | tee -a $RESULT
+done
+rm -f benchmark_stepmax.mac
+echo Benchmark complete, results in $RESULT.
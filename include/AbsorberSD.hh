@@ -0,0 +1,44 @@
+/**
+ * @file /ECal_MT/include/AbsorberSD.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's sensitive detector of the tungsten absorber and the fiber claddings.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef AbsorberSD_h
+#define AbsorberSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+class G4Step;
+class G4HCofThisEvent;
+class EventAction;
+
+/**
+ * @brief Scoring of the passive volumes of the calorimeter
+ *
+ * Attached only if the shower is scored (/ECal/scoring/shower): the steps fill the profiles
+ * and the step records through EventAction. The calorimeter deposit is summed by the
+ * G4PSEnergyDeposit scorer of the same volumes.
+ *
+ **/
+
+class AbsorberSD : public G4VSensitiveDetector
+{
+  public:
+    AbsorberSD(const G4String& name);
+    virtual ~AbsorberSD();
+
+    virtual void   Initialize(G4HCofThisEvent* hce);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory*);
+
+  private:
+    EventAction* fEventAction;  /// event action of this thread, looked up at every event
+};
+
+#endif
+
+/// End of file
@@ -17,6 +17,7 @@
 #include "RunAction.hh"
 #include "EventAction.hh"
 #include "SteppingAction.hh"
+#include "StackingAction.hh"
 
 class ActionInitialization : public G4VUserActionInitialization
 {
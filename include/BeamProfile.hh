@@ -0,0 +1,63 @@
+/**
+ * @file /ECal_MT/include/BeamProfile.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's beam spot and angular spread of the primary particle.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef BeamProfile_h
+#define BeamProfile_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4GenericMessenger.hh"
+
+/// Transverse shapes of the beam spot
+
+enum BeamShape
+{
+  kBeamDisk = 0,      /// uniform in a disk (former beam spot)
+  kBeamGaussian,      /// Gaussian in x and y
+  kBeamSquare,        /// uniform over the face of the fiber grid
+  kBeamPoint          /// at the origin
+};
+
+/**
+ * @brief Beam profile of the run, owned by the master run action
+ *
+ * The settings are changed on the master only (/ECal/beam/). Workers sample them with the
+ * G4Random engine of their thread, which is reseeded for every event: there is no shared
+ * state and no lock, and an event is reproduced by its seed.
+ *
+ **/
+
+class BeamProfile
+{
+  public:
+    BeamProfile(G4int fiber, G4double pitch);
+    ~BeamProfile();
+
+    static const BeamProfile* Instance() {return fInstance;}
+
+    void SetShape(const G4String& shape);
+
+    /// Start point (z = 0) and direction (around +z) of a primary, called by workers
+    void Sample(G4ThreeVector& position, G4ThreeVector& direction) const;
+
+  private:
+    static BeamProfile* fInstance;
+
+    BeamShape fShape;
+    G4double  fRadius;      /// radius of the disk
+    G4double  fSigma;       /// standard deviation of the Gaussian in x and y
+    G4double  fHalfWidth;   /// half width of the face of the fiber grid
+    G4double  fDivergence;  /// standard deviation of the xz and yz angles to +z, 0: parallel beam
+    G4GenericMessenger* fMessenger;
+};
+
+#endif
+
+/// End of file
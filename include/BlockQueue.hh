@@ -0,0 +1,123 @@
+/**
+ * @file /ECal_MT/include/BlockQueue.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's bounded lock-free queue used to pass output blocks between threads.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef BlockQueue_h
+#define BlockQueue_h 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Bounded multi-producer queue of pointers without locks
+ *
+ * Every cell has a sequence number telling whether it is free for the producer of a given
+ * position or filled for the consumer of that position (D. Vyukov's bounded queue).
+ * Push and Pop never block, they return false on a full or an empty queue.
+ *
+ **/
+
+template <class T>
+class BlockQueue
+{
+  public:
+    explicit BlockQueue(std::size_t capacity);
+
+    bool Push(T* value);
+    bool Pop(T*& value);
+
+    /// Number of elements, only a snapshot while other threads are working
+    std::size_t Size() const
+    { return fEnqueue.load(std::memory_order_relaxed) - fDequeue.load(std::memory_order_relaxed); }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> sequence;
+      T*                       data;
+    };
+
+    std::unique_ptr<Cell[]>  fCells;
+    std::size_t              fMask;
+    char                     fPad0[64];  /// producers and the consumer work on separate cache lines
+    std::atomic<std::size_t> fEnqueue;
+    char                     fPad1[64];
+    std::atomic<std::size_t> fDequeue;
+};
+
+/// @brief Constructor of Block queue, capacity is rounded up to a power of two
+
+template <class T>
+BlockQueue<T>::BlockQueue(std::size_t capacity)
+: fMask(0), fEnqueue(0), fDequeue(0)
+{
+  std::size_t size = 2;
+  while (size < capacity) { size <<= 1; }
+  fCells.reset(new Cell[size]);
+  fMask = size - 1;
+  for (std::size_t i = 0; i < size; i++)
+  {
+    fCells[i].sequence.store(i, std::memory_order_relaxed);
+    fCells[i].data = 0;
+  }
+}
+
+/// @brief Adding an element, false if the queue is full
+
+template <class T>
+bool BlockQueue<T>::Push(T* value)
+{
+  Cell* cell;
+  std::size_t pos = fEnqueue.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    cell = &fCells[pos & fMask];
+    std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+    std::intptr_t dif = (std::intptr_t)seq - (std::intptr_t)pos;
+    if (dif == 0)
+    {
+      if (fEnqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+    }
+    else if (dif < 0) { return false; }
+    else { pos = fEnqueue.load(std::memory_order_relaxed); }
+  }
+  cell->data = value;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+/// @brief Removing the oldest element, false if the queue is empty
+
+template <class T>
+bool BlockQueue<T>::Pop(T*& value)
+{
+  Cell* cell;
+  std::size_t pos = fDequeue.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    cell = &fCells[pos & fMask];
+    std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+    std::intptr_t dif = (std::intptr_t)seq - (std::intptr_t)(pos + 1);
+    if (dif == 0)
+    {
+      if (fDequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+    }
+    else if (dif < 0) { return false; }
+    else { pos = fDequeue.load(std::memory_order_relaxed); }
+  }
+  value = cell->data;
+  cell->sequence.store(pos + fMask + 1, std::memory_order_release);
+  return true;
+}
+
+#endif
+
+/// End of file
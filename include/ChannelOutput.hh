@@ -0,0 +1,56 @@
+/**
+ * @file /ECal_MT/include/ChannelOutput.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's writer of the per-event channel rows.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef ChannelOutput_h
+#define ChannelOutput_h 1
+
+#include "globals.hh"
+#include "ChannelRecord.hh"
+#include "G4Threading.hh"
+
+#include <atomic>
+#include <cstdio>
+
+/**
+ * @brief Channel file owned by the master run action
+ *
+ * A row is a single write of a few kB per event, so workers simply take a mutex for it.
+ *
+ **/
+
+class ChannelOutput
+{
+  public:
+    ChannelOutput();
+    ~ChannelOutput();
+
+    static ChannelOutput* Instance() {return fInstance;}
+
+    void Start(const G4String& fileName, G4int nFiber);
+    void Stop();
+    G4bool IsRunning() const {return fRunning.load(std::memory_order_acquire);}
+
+    /// called by workers at the end of their events
+    void WriteRow(G4int eventID, const float* edep, const std::int32_t* photons);
+
+  private:
+    static ChannelOutput* fInstance;
+
+    G4String          fFileName;
+    std::FILE*        fFile;
+    std::uint32_t     fChannels;
+    std::uint64_t     fRows;
+    std::atomic<bool> fRunning;
+    G4Mutex           fMutex;
+};
+
+#endif
+
+/// End of file
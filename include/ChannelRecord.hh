@@ -0,0 +1,36 @@
+/**
+ * @file /ECal_MT/include/ChannelRecord.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's fixed size per-event row of the fiber channels.
+ * This header has no Geant4 dependency, so the ROOT macro can include it too.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef ChannelRecord_h
+#define ChannelRecord_h 1
+
+#include <cstdint>
+
+/**
+ * @brief Header of the channel file (channels.bin)
+ *
+ * Channel c is the fiber of copy number c = i*nFiber + j. The header is followed by one row
+ * per event: int32 event ID, nChannels float energy deposits in the fiber core (MeV),
+ * then nChannels int32 optical photon counts in the Detector behind the fiber.
+ * Rows of different threads are not ordered by event ID.
+ *
+ **/
+
+struct ChannelFileHeader
+{
+  char          magic[8];   /// "ECALCHN1"
+  std::uint32_t nChannels;
+  std::int32_t  nFiber;     /// number of fibers in one line
+};
+
+#endif
+
+/// End of file
@@ -27,7 +27,51 @@
 #include "G4RotationMatrix.hh"
 #include "G4Tubs.hh"
 #include "G4VisAttributes.hh"
+#include "G4GenericMessenger.hh"
 
+#include <utility>
+#include <vector>
+
+/// Ways of building the fiber grid, the channel numbering is the same in all of them
+
+enum FiberPlacement
+{
+  kFiberPlacement = 0,    /// 2*fFiber^2 G4PVPlacement (original layout)
+  kFiberReplica,          /// Tank replicated in columns and cells, one fiber per cell
+  kFiberParameterised     /// one G4PVParameterised of fFiber^2 fibers
+};
+
+/// Transport of the optical photons in the fibers
+
+enum FiberTransport
+{
+  kFiberTransportFull = 0,  /// G4OpBoundaryProcess at every reflection
+  kFiberTransportFast,      /// FiberOpticsModel in the "Fibers" region
+  kFiberTransportTable,     /// FiberOpticsModel with the FiberLightTable of full tracking
+  kFiberTransportBatch      /// photons of an event collected by StackingAction for FiberBatchTransport
+};
+
+/// Killing optical photons at creation which cannot reach the Detector (StackingAction)
+
+enum TrappingCut
+{
+  kTrappingCutOff = 0,
+  kTrappingCutOn,
+  kTrappingCutValidate      /// photons are tracked, the ones outside the cut are only counted
+};
+
+/// Where the photon detection efficiency of the Detector is applied
+
+enum EfficiencyMode
+{
+  kEfficiencyOff = 0,       /// every photon reaching the Detector is counted
+  kEfficiencyAtCreation,    /// sampled when the photon is created (StackingAction)
+  kEfficiencyAtDetector     /// sampled when the photon reaches the Detector (DetectorSD)
+};
+
+class FiberOptics;
+class FiberLightTable;
+class RegionLimits;
 
 class DetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -36,9 +80,84 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     virtual ~DetectorConstruction();
 
     virtual G4VPhysicalVolume* Construct();
+    virtual void ConstructSDandField();
+
+    void SetFiberPlacement(const G4String& placement);
+    void Benchmark(G4int nPoints);
+    void CheckBatchTransport(G4int nPhotons);
+    void SetFiberTransport(const G4String& transport);
+    void SetTrappingCut(const G4String& cut);
+    void SetEfficiencyMode(const G4String& mode);
+    void SetEfficiencyCurve(const G4String& curve);
+    void SetAbsorberCut(G4double cut);
+    void SetFiberCut(G4double cut);
+    void SetPhotodetectorCut(G4double cut);
+
+    G4int    GetFiber() const {return fFiber;}
+    G4double GetFiberPitch() const {return fPitch;}
+    G4double GetProfileOrigin() const {return fProfileOrigin;}
+    G4double GetProfileDepth() const {return fProfileDepth;}
+    FiberPlacement GetFiberPlacement() const {return fPlacement;}
+    FiberTransport GetFiberTransport() const {return fTransport;}
+    TrappingCut GetTrappingCut() const {return fTrappingCut;}
+    G4ThreeVector ToFiberFrame(const G4ThreeVector& position) const;
+    G4int GetChannel(const G4ThreeVector& position) const;
+    EfficiencyMode GetEfficiencyMode() const {return fEfficiencyMode;}
+    G4double GetDetectionEfficiency(G4double energy) const;
+    const FiberOptics* GetFiberOptics() const {return fOptics;}
+    FiberLightTable* GetFiberLightTable() const {return fLightTable;}
+    G4bool NeedsFiberLightTable() const;
+    G4bool IsFillingFiberLightTable() const {return fFillingTable;}
+    void FillFiberLightTable();
+    const G4String& GetFiberLightTableFile() const {return fLightTableFile;}
+    G4int GetFiberLightTablePhotons() const {return fLightTablePhotons;}
+    G4int GetPhotonWeight() const {return fPhotonWeight;}
+    G4double GetTimeWindow() const {return fTimeWindow;}
+    G4double GetLateEnergyThreshold() const {return fLateEnergyThreshold;}
+    G4double GetAbsorberCut() const {return fAbsorberCut;}
+    G4double GetFiberCut() const {return fFiberCut;}
+    G4double GetPhotodetectorCut() const {return fPhotodetectorCut;}
+    G4bool IsScoringShower() const {return fScoreShower;}
+    void PrintRegionCuts() const;
+
+    /// A track past the readout window which is not digitised anymore: optical photons and slow tracks
+    G4bool IsLate(G4double globalTime, G4bool optical, G4double kineticEnergy) const
+    { return fTimeWindow > 0 && globalTime > fTimeWindow && (optical || kineticEnergy < fLateEnergyThreshold); }
 private:
+    void ToGridCell(const G4ThreeVector& position, G4double& x, G4double& y, G4double& i, G4double& j) const;
+    void ApplyRegionCut(const G4String& regionName, G4double cut);
+
     G4int fFiber;
     G4bool fCalSim;
+    G4double fPitch;         /// distance of fiber centers
+    G4double fProfileOrigin; /// z where the longitudinal shower profile starts
+    G4double fProfileDepth;  /// length of the longitudinal shower profile
+    FiberPlacement fPlacement;
+    FiberTransport fTransport;
+    TrappingCut fTrappingCut;
+    G4ThreeVector fTankCenter;   /// center of the fiber grid
+    EfficiencyMode fEfficiencyMode;
+    std::vector<G4double> fEfficiencyEnergy;  /// photon detection efficiency curve, increasing energies
+    std::vector<G4double> fEfficiencyValue;
+    FiberOptics* fOptics;    /// light transport of the core, built with the materials
+    FiberLightTable* fLightTable; /// light transport of full tracking (table transport only)
+    G4String fLightTableFile;     /// cache file of the table, named after its key
+    G4int fLightTablePhotons;     /// photons tracked to fill the table
+    G4bool fFillingTable;         /// the current run is started by FillFiberLightTable
+    G4int fPhotonWeight;          /// 1/weight of the scintillation and Cerenkov photons is generated
+    G4double fTimeWindow;         /// readout integration window from the start of the event, 0: no window
+    G4double fLateEnergyThreshold; /// tracks below this kinetic energy are killed past the window as well
+    G4double fAbsorberCut;        /// production cut of the "Absorber" region (Tank), 0: default cut
+    G4double fFiberCut;           /// production cut of the "Fibers" region
+    G4double fPhotodetectorCut;   /// production cut of the "Photodetector" region (Detector)
+    G4bool fScoreShower;          /// AbsorberSD scores the tungsten and claddings for the profiles and step records
+    RegionLimits* fLimits;        /// step limits and killing thresholds of the regions (/ECal/stepMax/, /ECal/killer/)
+    G4VPhysicalVolume* fWorld;
+    G4VPhysicalVolume* fTank;
+    G4GenericMessenger* fMessenger;
+    G4GenericMessenger* fOpticsMessenger;
+    G4GenericMessenger* fCutsMessenger;
+    G4GenericMessenger* fScoringMessenger;
     
 };
 
@@ -0,0 +1,53 @@
+/**
+ * @file /ECal_MT/include/DetectorSD.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's sensitive detector of the photodetector plate.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef DetectorSD_h
+#define DetectorSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "FiberHit.hh"
+
+#include <vector>
+
+class G4Step;
+class G4HCofThisEvent;
+class G4ParticleDefinition;
+class DetectorConstruction;
+class EventAction;
+
+class DetectorSD : public G4VSensitiveDetector
+{
+  public:
+    DetectorSD(const G4String& name, const G4String& hitsCollectionName, G4int nFiber);
+    virtual ~DetectorSD();
+
+    virtual void   Initialize(G4HCofThisEvent* hce);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory*);
+
+    void AddPhoton(const G4ThreeVector& position, G4double time, G4double energy);
+
+  private:
+    G4bool    ReadOut(G4Step* step);
+    G4bool    IsDetected(G4double energy) const;
+    G4bool    IsInWindow(G4double time) const;
+    FiberHit* GetHit(G4int channel);
+
+    FiberHitsCollection*        fHitsCollection;
+    std::vector<G4int>          fHitIndex;       /// channel -> index in the collection, -1 if no hit yet
+    const G4ParticleDefinition* fOpticalPhoton;
+    const DetectorConstruction* fDetector;
+    EventAction*                fEventAction;    /// scorer of the steps, looked up at every event
+    G4bool                      fEfficiency;     /// photon detection efficiency sampled here, read at every event
+    G4int                       fWeight;         /// weight of a detected photon
+};
+
+#endif
+
+/// End of file
@@ -15,10 +15,18 @@
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 #include "Run.hh"
+#include "StepRecordBuffer.hh"
+#include "ChannelOutput.hh"
+#include "GenstepRecord.hh"
 
 #include "G4Event.hh"
 #include "G4RunManager.hh"
 
+class StackingAction;
+class StepDictionary;
+class DetectorConstruction;
+class G4Step;
+
 class EventAction : public G4UserEventAction
 {
   public:
@@ -27,9 +35,34 @@ class EventAction : public G4UserEventAction
     
     virtual void BeginOfEventAction(const G4Event* event);
     virtual void EndOfEventAction(const G4Event* event);
-    void SetHitNumber(){detectorHit++;}
+
+    G4int GetEventID() const {return fEventID;}
+    Run* GetRun() const {return fRun;}
+    G4bool IsLoggingSteps() const {return fLogSteps;}
+    StepRecordBuffer* GetStepBuffer() {return fStepBuffer;}
+    G4bool IsLoggingGensteps() const {return fLogGensteps;}
+    void AddGenstep(const GenstepRecord& genstep) {fGensteps.push_back(genstep);}
+    void SetStackingAction(StackingAction* stackingAction) {fStackingAction = stackingAction;}
+
+    /// called by the sensitive detectors for every step of the instrumented volumes, scores no kill
+    void ScoreStep(const G4Step* step);
   private:
-    G4int detectorHit;
+    G4int fFiberHCID;              /// collection IDs of the sensitive detectors
+    G4int fDetectorHCID;
+    G4int fCalorimeterHCID;        /// G4PSEnergyDeposit of the tungsten and the claddings
+    G4int fEventID;
+    Run* fRun;                     /// current run of this thread
+    G4bool fLogSteps;              /// step records are written in this run
+    StepRecordBuffer* fStepBuffer; /// binary step records of this thread
+    std::vector<float> fChannelEdep;          /// dense row of the event, one entry per fiber
+    std::vector<std::int32_t> fChannelPhotons;
+    G4bool fLogGensteps;           /// gensteps are written in this run
+    std::vector<GenstepRecord> fGensteps;     /// gensteps of the event
+    StackingAction* fStackingAction; /// holder of the batch of optical photons of this thread
+    const DetectorConstruction* fDetector;
+    StepDictionary* fDictionary;   /// ID lookups of this thread
+    G4bool fTableRun;              /// the run fills the light table, nothing is scored
+    G4bool fScoreShower;           /// steps fill the profiles and step records (/ECal/scoring/shower)
 };
 
 #endif
@@ -0,0 +1,59 @@
+/**
+ * @file /ECal_MT/include/EventSeeder.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's random seeds of the events derived from the master seed.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef EventSeeder_h
+#define EventSeeder_h 1
+
+#include "globals.hh"
+#include "G4GenericMessenger.hh"
+
+/**
+ * @brief Seeds of every event from the master seed and the index of the event, owned by the master run action
+ *
+ * The index of an event is its ID plus the events of the previous runs of the job (or the
+ * first index set by /ECal/random/firstEvent). The engine of the thread is reseeded when the
+ * primaries of the event are generated, so an event is the same with any number of threads,
+ * and one event can be replayed alone from its index.
+ *
+ **/
+
+class EventSeeder
+{
+  public:
+    EventSeeder(G4long seed);
+    ~EventSeeder();
+
+    static EventSeeder* Instance() {return fInstance;}
+
+    void SetSeed(G4long seed) {fSeed = seed;}
+    G4long GetSeed() const {return fSeed;}
+    void SetFirstEvent(G4long index) {fFirstEvent = index;}
+    G4long GetFirstEvent() const {return fFirstEvent;}
+
+    /// Reseeding the engine of the calling thread for an event of the current run
+    void SeedEvent(G4int eventID) const;
+
+    void BeginOfRun() const;
+    void EndOfRun(G4int events) {fFirstEvent += events;}
+
+  private:
+    static EventSeeder* fInstance;
+
+    G4long fSeed;          /// master seed
+    G4long fFirstEvent;    /// index of event 0 of the current run
+    G4GenericMessenger* fMessenger;
+
+    void SetSeedCommand(const G4String& seed);
+    void SetFirstEventCommand(const G4String& index);
+};
+
+#endif
+
+/// End of file
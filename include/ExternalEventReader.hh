@@ -0,0 +1,83 @@
+/**
+ * @file /ECal_MT/include/ExternalEventReader.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's streaming reader of external generator events.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef ExternalEventReader_h
+#define ExternalEventReader_h 1
+
+#include "globals.hh"
+#include "ExternalEventRecord.hh"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Memory mapped file of external events (HEPEVT text or ECALEVT1 binary), owned by
+ * the master run action
+ *
+ * An index thread walks the mapping ahead of the workers and publishes the offset of every
+ * event through an atomic count, so the pages of the next events are already resident when a
+ * worker asks for them. Workers parse their event straight from the mapping without a lock;
+ * event n of the run reads event (first + n) of the file whichever thread simulates it.
+ *
+ **/
+
+class ExternalEventReader
+{
+  public:
+    ExternalEventReader();
+    ~ExternalEventReader();
+
+    static ExternalEventReader* Instance() {return fInstance;}
+
+    G4bool Open(const G4String& fileName);
+    void Close();
+    G4bool IsOpen() const {return fData != 0;}
+    G4bool IsBinary() const {return fBinary;}
+    const G4String& GetFileName() const {return fFileName;}
+
+    void SetFirstEvent(std::size_t first) {fFirst = first;}
+    std::size_t GetFirstEvent() const {return fFirst;}
+
+    /// called by workers at the start of their events
+    G4bool ReadEvent(std::size_t index, std::vector<ExternalParticle>& particles);
+
+    void Report() const;
+
+  private:
+    void IndexLoop();
+    const char* NextEvent(const char* event) const;
+    G4bool ParseText(const char* event, std::vector<ExternalParticle>& particles) const;
+
+    static const std::size_t kChunk = 4096;      /// offsets per chunk of the index
+    static const std::size_t kReadAhead = 16384; /// events indexed ahead of the furthest worker
+
+    static ExternalEventReader* fInstance;
+
+    G4String                   fFileName;
+    const char*                fData;      /// mapping of the file
+    std::size_t                fSize;
+    std::size_t                fBegin;     /// offset of the first event
+    G4bool                     fBinary;
+    std::size_t                fFirst;     /// event of the file read by event 0 of the run
+    std::vector<std::uint64_t*> fChunks;   /// event offsets, the slots are sized at opening
+    std::atomic<std::size_t>   fIndexed;   /// events whose offset is published
+    std::atomic<std::size_t>   fRequested; /// furthest event asked for, plus one
+    std::atomic<bool>          fIndexDone;
+    std::atomic<bool>          fStop;
+    std::atomic<std::uint64_t> fEventsRead;
+    std::atomic<std::uint64_t> fStalls;    /// reads that waited for the index thread
+    std::atomic<bool>          fPastEnd;   /// a read beyond the last event has been reported
+    std::thread                fIndexer;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,50 @@
+/**
+ * @file /ECal_MT/include/ExternalEventRecord.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's compact binary form of external generator events.
+ * This header has no Geant4 dependency, so a converter of generator output can include it too.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef ExternalEventRecord_h
+#define ExternalEventRecord_h 1
+
+#include <cstdint>
+
+/**
+ * @brief Final state particle of an external event
+ *
+ * Momenta are stored in GeV like in the HEPEVT text form, the mass is taken from the
+ * particle table of Geant4.
+ *
+ **/
+
+struct ExternalParticle
+{
+  std::int32_t pdg;         /// PDG code, ions as 100ZZZAAAI
+  float px, py, pz;         /// momentum (GeV)
+};
+
+static_assert(sizeof(ExternalParticle) == 16, "ExternalParticle layout must not contain padding");
+
+/**
+ * @brief Header of the binary event file
+ *
+ * The header is followed by one block per event: a uint32 count of particles and the
+ * particles. Files without this header are read as HEPEVT text (an NHEP line, then NHEP
+ * lines of ISTHEP IDHEP JDAHEP1 JDAHEP2 PHEP1 PHEP2 PHEP3 PHEP5 in GeV).
+ *
+ **/
+
+struct ExternalFileHeader
+{
+  char          magic[8];   /// "ECALEVT1"
+  std::uint32_t recordSize; /// sizeof(ExternalParticle) of the writer
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,97 @@
+/**
+ * @file /ECal_MT/include/FiberBatchTransport.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's batched transport of the optical photons of an event in the fiber grid.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef FiberBatchTransport_h
+#define FiberBatchTransport_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+#include <vector>
+
+class FiberOptics;
+class DetectorSD;
+
+/**
+ * @brief Optical photons of an event collected and sent to the Detector together
+ *
+ * Photons are stored as structure of arrays in the frame of their fiber. A batch is
+ * processed in three passes: a scalar pass reading the material properties at the photon
+ * energies and a block of random numbers from the engine of the thread, a pass of plain
+ * arithmetic over the arrays without branches or calls (vectorised by the compiler), and
+ * a scalar pass handing the detected photons to DetectorSD.
+ *
+ * The arithmetic pass is the model of FiberOptics::Transport: the wall reflections of the
+ * core/cladding (PS/PMMA) interface with the Fresnel reflectivity, the refracted photons
+ * lost in the painted cladding at the tungsten absorber, absorption in the core and the
+ * Fresnel transmission of the end face into the Detector window, for unpolarised light.
+ * FiberOptics::Transport leaves the end face to the boundary process, so the two agree
+ * up to that transmission factor, which Validate checks. One thread owns one batch.
+ *
+ **/
+
+class FiberBatchTransport
+{
+  public:
+    FiberBatchTransport(const FiberOptics* optics, std::size_t batchSize = 4096);
+
+    void SetDetectorSD(DetectorSD* detectorSD) {fDetectorSD = detectorSD;}
+
+    /// Collecting a photon of a fiber core, the batch is processed when it is full
+    inline void Add(const G4ThreeVector& global, const G4ThreeVector& local, const G4ThreeVector& direction,
+                    G4double energy, G4double time)
+    {
+      fGlobalX.push_back(global.x());
+      fGlobalY.push_back(global.y());
+      fX.push_back(local.x());
+      fY.push_back(local.y());
+      fZ.push_back(local.z());
+      fUX.push_back(direction.x());
+      fUY.push_back(direction.y());
+      fUZ.push_back(direction.z());
+      fEnergy.push_back(energy);
+      fTime.push_back(time);
+      if (fX.size() == fBatchSize) { Flush(); }
+    }
+
+    G4int Flush();
+    void Clear();
+    G4double Validate(G4int photons);
+
+    G4long GetPhotons() const {return fPhotons;}
+    G4long GetDetected() const {return fDetected;}
+    G4long GetBatches() const {return fBatches;}
+    void ResetCounts() {fPhotons = fDetected = fBatches = 0;}
+
+  private:
+    void Evaluate(G4int n);
+
+    const FiberOptics* fOptics;
+    DetectorSD*        fDetectorSD;
+    std::size_t        fBatchSize;
+
+    /// photons of the batch
+    std::vector<G4double> fGlobalX, fGlobalY;     /// position in the grid (channel)
+    std::vector<G4double> fX, fY, fZ;             /// position in the fiber
+    std::vector<G4double> fUX, fUY, fUZ;
+    std::vector<G4double> fEnergy, fTime;
+
+    /// material properties, random numbers and results of the batch
+    std::vector<G4double> fCoreIndex, fCladdingIndex, fWindowIndex, fAbsorption, fRandom;
+    std::vector<G4double> fProbability, fArrival;
+
+    G4long fPhotons;
+    G4long fDetected;
+    G4long fBatches;
+};
+
+#endif
+
+/// End of file
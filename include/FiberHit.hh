@@ -0,0 +1,68 @@
+/**
+ * @file /ECal_MT/include/FiberHit.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's hit class of one readout channel in an event.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef FiberHit_h
+#define FiberHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+/**
+ * @brief Sum of one channel in an event
+ *
+ * A hit is not made per step: the sensitive detectors keep one hit per channel and
+ * add every step of the event to it, so a collection has at most one entry per channel.
+ *
+ **/
+
+class FiberHit : public G4VHit
+{
+  public:
+    FiberHit(G4int channel);
+    virtual ~FiberHit();
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void* hit);
+
+    void AddEdep(G4double edep) {fEdep += edep;}
+    void AddPhoton(G4double time, G4int weight = 1) {fPhotons += weight; if (time < fTime) {fTime = time;}}
+
+    G4int    GetChannel() const {return fChannel;}
+    G4double GetEdep() const {return fEdep;}
+    G4int    GetPhotons() const {return fPhotons;}   /// sum of the photon weights
+    G4double GetTime() const {return fTime;}      /// arrival of the first photon
+
+  private:
+    G4int    fChannel;
+    G4double fEdep;
+    G4int    fPhotons;
+    G4double fTime;
+};
+
+typedef G4THitsCollection<FiberHit> FiberHitsCollection;
+
+extern G4ThreadLocal G4Allocator<FiberHit>* FiberHitAllocator;
+
+inline void* FiberHit::operator new(size_t)
+{
+  if (!FiberHitAllocator) { FiberHitAllocator = new G4Allocator<FiberHit>; }
+  return (void*)FiberHitAllocator->MallocSingle();
+}
+
+inline void FiberHit::operator delete(void* hit)
+{
+  FiberHitAllocator->FreeSingle((FiberHit*)hit);
+}
+
+#endif
+
+/// End of file
@@ -0,0 +1,100 @@
+/**
+ * @file /ECal_MT/include/FiberLightTable.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's table of the light transport in a fiber, filled with full optical tracking.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef FiberLightTable_h
+#define FiberLightTable_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+#include <cstdint>
+#include <vector>
+
+class G4Material;
+
+/// Optical photons of one event of the run filling the table
+const G4int kFiberLightPhotonsPerEvent = 1000;
+
+/// Header of the cache file, followed by the emitted, detected and arrival time arrays (doubles)
+
+struct FiberLightTableHeader
+{
+  char          magic[8];       /// "ECALLUT1"
+  std::uint64_t key;            /// hash of the binning, the fiber and the optical properties
+  std::int32_t  nDepth;
+  std::int32_t  nRadius;
+  std::int32_t  nCos;
+  std::int32_t  nTime;
+};
+
+/**
+ * @brief Probability of reaching the Detector and arrival time of photons born in a fiber core
+ *
+ * Bins of the emission depth (distance to the end face at the Detector, 0 to 2*halfLength),
+ * of the squared radius (equal areas of the core) and of the direction cosine along the
+ * fiber axis (-1 to 1). Every bin counts the emitted and the detected photons and holds the
+ * distribution of the delay between emission and detection (0 to maxTime, the last bin
+ * takes the later photons). Positions and directions are local to the fiber.
+ *
+ **/
+
+class FiberLightTable
+{
+  public:
+    FiberLightTable(G4int nDepth, G4int nRadius, G4int nCos, G4int nTime,
+                    G4double halfLength, G4double coreRadius, G4double maxTime);
+
+    void SetMaterials(const std::vector<const G4Material*>& materials);
+    void SetOrigin(const G4ThreeVector& origin) {fOrigin = origin;}
+    void Reset();
+
+    G4int GetBin(const G4ThreeVector& position, const G4ThreeVector& direction) const;
+    void  AddEmitted(G4int bin) {fEmitted[bin] += 1;}
+    void  AddDetected(G4int bin, G4double delay);
+    void  Merge(const FiberLightTable& other);
+
+    G4double GetProbability(G4int bin) const
+    { return fEmitted[bin] > 0 ? fDetected[bin] / fEmitted[bin] : 0.; }
+    G4double SampleTime(G4int bin, G4double random) const;
+
+    G4bool Save(const G4String& fileName) const;
+    G4bool Load(const G4String& fileName);
+
+    G4bool IsEmpty() const {return fTotalEmitted == 0;}
+    G4double GetTotalEmitted() const {return fTotalEmitted;}
+    G4double GetTotalDetected() const {return fTotalDetected;}
+    std::uint64_t GetKey() const {return fKey;}
+    const G4ThreeVector& GetOrigin() const {return fOrigin;}
+    G4double GetHalfLength() const {return fHalfLength;}
+    G4double GetCoreRadius() const {return fCoreRadius;}
+
+  private:
+    void Count();
+
+    G4int         fNDepth;
+    G4int         fNRadius;
+    G4int         fNCos;
+    G4int         fNTime;
+    G4double      fHalfLength;
+    G4double      fCoreRadius;
+    G4double      fMaxTime;
+    std::uint64_t fKey;
+    G4ThreeVector fOrigin;          /// center of the fiber filled with full tracking (global)
+
+    std::vector<G4double> fEmitted;
+    std::vector<G4double> fDetected;
+    std::vector<G4double> fTime;    /// nTime delay bins per bin
+    G4double              fTotalEmitted;
+    G4double              fTotalDetected;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,82 @@
+/**
+ * @file /ECal_MT/include/FiberOptics.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's analytic light transport in the fiber core.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef FiberOptics_h
+#define FiberOptics_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4MaterialPropertyVector.hh"
+
+#include <cmath>
+
+class G4Material;
+
+/**
+ * @brief Path of an optical photon from its origin in the core to the end face at the Detector
+ *
+ * Coordinates are local to the fiber: axis along z, the Detector behind z = +halfLength.
+ * The straight path is unfolded at the core wall, where every reflection has the same angle
+ * of incidence and keeps the photon with the Fresnel reflectivity of the core/cladding
+ * interface (unpolarised light). A photon entering the cladding is lost, the painted
+ * cladding surface absorbs it, and so is a photon going to the back end (-z).
+ * Absorption in the core uses ABSLENGTH and the refractive indices RINDEX of the materials.
+ *
+ * A wall reflection does not change the direction cosine along the axis, so a photon outside
+ * the acceptance of the end face (total internal reflection towards the Detector window)
+ * never reaches the Detector; CanReachDetector is this test, exact while the core does not
+ * scatter (no RAYLEIGH or MIEHG).
+ *
+ **/
+
+class FiberOptics
+{
+  public:
+    FiberOptics(G4double coreRadius, G4double halfLength, const G4Material* core, const G4Material* cladding,
+                const G4Material* window);
+
+    G4bool IsInCore(const G4ThreeVector& position) const
+    { return position.perp2() < fCoreRadius*fCoreRadius && std::fabs(position.z()) < fHalfLength; }
+
+    /// False if the photon can never reach the Detector: outside the core, going backwards or outside the end face cone
+    inline G4bool CanReachDetector(const G4ThreeVector& position, const G4ThreeVector& direction, G4double energy) const
+    {
+      if (!IsInCore(position)) { return false; }
+      if (fScattering) { return true; }
+      G4double ratio = fWindowIndex ? fWindowIndex->Value(energy) / GetRefractiveIndex(energy) : 0.;
+      G4double uz = direction.z();
+      return uz > 0 && uz*uz > 1 - ratio*ratio;
+    }
+
+    G4double Transport(G4ThreeVector& position, G4ThreeVector& direction, G4double energy,
+                       G4double& length, G4double threshold = 0.) const;
+
+    G4double GetRefractiveIndex(G4double energy) const;
+    G4double GetAbsorptionLength(G4double energy) const;
+    G4double GetCladdingIndex(G4double energy) const {return fCladdingIndex ? fCladdingIndex->Value(energy) : 1.;}
+    G4double GetWindowIndex(G4double energy) const {return fWindowIndex ? fWindowIndex->Value(energy) : 1.;}
+    G4double GetCoreRadius() const {return fCoreRadius;}
+    G4double GetHalfLength() const {return fHalfLength;}
+
+    static G4double Reflectivity(G4double cosIncidence, G4double n1, G4double n2);
+
+  private:
+    G4double                  fCoreRadius;
+    G4double                  fHalfLength;
+    G4MaterialPropertyVector* fCoreIndex;       /// RINDEX of the core
+    G4MaterialPropertyVector* fCladdingIndex;   /// RINDEX of the cladding
+    G4MaterialPropertyVector* fAbsorption;      /// ABSLENGTH of the core
+    G4MaterialPropertyVector* fWindowIndex;     /// RINDEX of the Detector window
+    G4bool                    fScattering;      /// the core changes the direction of the photons
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,53 @@
+/**
+ * @file /ECal_MT/include/FiberOpticsModel.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's fast simulation model of the optical photons in the fibers.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef FiberOpticsModel_h
+#define FiberOpticsModel_h 1
+
+#include "G4VFastSimulationModel.hh"
+
+class FiberOptics;
+class FiberLightTable;
+class DetectorSD;
+class G4Region;
+
+/**
+ * @brief Moving new optical photons of the "Fibers" region to the Detector in one step
+ *
+ * The model is triggered on the first step of a photon. Photons of the cladding and photons
+ * failing the survival probability of FiberOptics are killed, the others are placed just
+ * in front of the end face with the arrival time of the path, and the boundary process and
+ * DetectorSD take them over from there.
+ *
+ * With a light table the photon is not moved: it is counted in DetectorSD with the probability
+ * and a delay of its bin and killed. The model stays idle while the table is being filled.
+ *
+ **/
+
+class FiberOpticsModel : public G4VFastSimulationModel
+{
+  public:
+    FiberOpticsModel(const G4String& name, G4Region* region, const FiberOptics* optics,
+                     const FiberLightTable* table = 0, DetectorSD* detectorSD = 0);
+    virtual ~FiberOpticsModel();
+
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle);
+    virtual G4bool ModelTrigger(const G4FastTrack& fastTrack);
+    virtual void   DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+
+  private:
+    const FiberOptics*     fOptics;
+    const FiberLightTable* fTable;
+    DetectorSD*            fDetectorSD;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,36 @@
+/**
+ * @file /ECal_MT/include/FiberParameterisation.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's parameterisation of the fiber grid.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef FiberParameterisation_h
+#define FiberParameterisation_h 1
+
+#include "G4VPVParameterisation.hh"
+#include "globals.hh"
+
+class G4VPhysicalVolume;
+
+/// Copy c = i*fFiber+j is the fiber (i, j) at the same position as in the placement layout
+
+class FiberParameterisation : public G4VPVParameterisation
+{
+  public:
+    FiberParameterisation(G4int nFiber, G4double pitch);
+    virtual ~FiberParameterisation();
+
+    virtual void ComputeTransformation(const G4int copyNo, G4VPhysicalVolume* physVol) const;
+
+  private:
+    G4int    fFiber;
+    G4double fPitch;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,48 @@
+/**
+ * @file /ECal_MT/include/FiberSD.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's sensitive detector of the fiber cores.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef FiberSD_h
+#define FiberSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "FiberHit.hh"
+#include "DetectorConstruction.hh"
+
+#include <vector>
+
+class G4Step;
+class G4HCofThisEvent;
+class G4VTouchable;
+class EventAction;
+
+class FiberSD : public G4VSensitiveDetector
+{
+  public:
+    FiberSD(const G4String& name, const G4String& hitsCollectionName,
+            G4int nFiber, FiberPlacement placement);
+    virtual ~FiberSD();
+
+    virtual void   Initialize(G4HCofThisEvent* hce);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory*);
+
+  private:
+    FiberHit* GetHit(G4int channel);
+    G4int GetChannel(const G4VTouchable* touchable) const;
+
+    FiberHitsCollection*  fHitsCollection;
+    std::vector<G4int>    fHitIndex;       /// channel -> index in the collection, -1 if no hit yet
+    G4int                 fFiber;
+    FiberPlacement        fPlacement;      /// where the fiber indices are in the touchable history
+    EventAction*          fEventAction;    /// scorer of the steps, looked up at every event
+};
+
+#endif
+
+/// End of file
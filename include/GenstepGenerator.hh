@@ -0,0 +1,74 @@
+/**
+ * @file /ECal_MT/include/GenstepGenerator.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's generator of the optical photons of recorded gensteps.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef GenstepGenerator_h
+#define GenstepGenerator_h 1
+
+#include "globals.hh"
+#include "GenstepRecord.hh"
+#include "G4ThreeVector.hh"
+#include "G4MaterialPropertyVector.hh"
+
+#include <map>
+#include <vector>
+
+class G4Event;
+class G4Material;
+
+/**
+ * @brief Scintillation and Cerenkov photons of a genstep as primary optical photons
+ *
+ * The sampling follows G4Scintillation and G4Cerenkov of PhysicsList: the yield, resolution
+ * scale, FASTCOMPONENT and SLOWCOMPONENT spectra with their time constants, and the
+ * RINDEX of the material of the genstep, read from the current material properties.
+ * Without Birks saturation, as the scintillation process of the workers. Built on every
+ * thread, the properties of a material are prepared at its first genstep.
+ *
+ **/
+
+class GenstepGenerator
+{
+  public:
+    GenstepGenerator() {}
+
+    G4int GeneratePhotons(const GenstepRecord& genstep, const G4Material* material,
+                          G4int weight, G4Event* event);
+
+  private:
+    struct Spectrum
+    {
+      std::vector<G4double> energy;
+      std::vector<G4double> integral;   /// cumulative, trapezoidal
+      G4double              timeConstant;
+    };
+
+    struct MaterialOptics
+    {
+      G4MaterialPropertyVector* rindex;
+      G4double                  maxIndex;
+      G4double                  yield;              /// photons per energy deposit
+      G4double                  resolutionScale;
+      G4double                  yieldRatio;         /// share of the fast component
+      std::vector<Spectrum>     components;         /// fast, then slow
+    };
+
+    const MaterialOptics& GetOptics(const G4Material* material);
+    G4double CerenkovPhotonsPerLength(const MaterialOptics& optics, G4double betaInverse, G4double charge) const;
+    G4int Scintillation(const GenstepRecord& genstep, const MaterialOptics& optics, G4int weight, G4Event* event);
+    G4int Cerenkov(const GenstepRecord& genstep, const MaterialOptics& optics, G4int weight, G4Event* event);
+    void AddPhoton(G4Event* event, const G4ThreeVector& position, G4double time, G4double energy,
+                   const G4ThreeVector& direction, const G4ThreeVector& polarization);
+
+    std::map<const G4Material*, MaterialOptics> fOptics;
+};
+
+#endif
+
+/// End of file
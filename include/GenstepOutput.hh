@@ -0,0 +1,58 @@
+/**
+ * @file /ECal_MT/include/GenstepOutput.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's writer of the optical photon generating steps.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef GenstepOutput_h
+#define GenstepOutput_h 1
+
+#include "globals.hh"
+#include "GenstepRecord.hh"
+#include "G4Threading.hh"
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+/**
+ * @brief Genstep file owned by the master run action
+ *
+ * Workers collect the gensteps of an event and write them as one block at its end under
+ * a mutex, as the channel rows. The material list of the header is the material table.
+ *
+ **/
+
+class GenstepOutput
+{
+  public:
+    GenstepOutput();
+    ~GenstepOutput();
+
+    static GenstepOutput* Instance() {return fInstance;}
+
+    void Start(const G4String& fileName);
+    void Stop();
+    G4bool IsRunning() const {return fRunning.load(std::memory_order_acquire);}
+
+    /// called by workers at the end of their events
+    void WriteEvent(G4int eventID, const std::vector<GenstepRecord>& records);
+
+  private:
+    static GenstepOutput* fInstance;
+
+    G4String          fFileName;
+    std::FILE*        fFile;
+    std::uint64_t     fEvents;
+    std::uint64_t     fRecords;
+    std::atomic<bool> fRunning;
+    G4Mutex           fMutex;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,71 @@
+/**
+ * @file /ECal_MT/include/GenstepReader.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's reader of the optical photon generating steps.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef GenstepReader_h
+#define GenstepReader_h 1
+
+#include "globals.hh"
+#include "GenstepRecord.hh"
+#include "G4Threading.hh"
+
+#include <cstdio>
+#include <vector>
+
+class G4Material;
+
+/**
+ * @brief Genstep file of a replay run, owned by the master run action
+ *
+ * Opening the file indexes its event blocks in the order of the event IDs, so event n of
+ * the replay run reads the n-th recorded event whichever thread wrote it. Workers read
+ * one block per event under a mutex. Materials are matched by name, so the optical
+ * properties of the current geometry are used.
+ *
+ **/
+
+class GenstepReader
+{
+  public:
+    GenstepReader();
+    ~GenstepReader();
+
+    static GenstepReader* Instance() {return fInstance;}
+
+    G4bool Open(const G4String& fileName);
+    void Close();
+    G4bool IsOpen() const {return fFile != 0;}
+
+    std::size_t GetNumberOfEvents() const {return fEvents.size();}
+    const G4Material* GetMaterial(G4int index) const {return fMaterials[index];}
+
+    /// called by workers at the start of their events
+    G4bool ReadEvent(G4int index, std::vector<GenstepRecord>& records);
+
+  private:
+    struct EventBlock
+    {
+      G4int         eventID;
+      std::uint32_t nRecords;
+      long          offset;     /// of the first record
+      bool operator<(const EventBlock& other) const {return eventID < other.eventID;}
+    };
+
+    static GenstepReader* fInstance;
+
+    G4String                       fFileName;
+    std::FILE*                     fFile;
+    std::vector<const G4Material*> fMaterials;  /// 0 if the material is not in the geometry
+    std::vector<EventBlock>        fEvents;
+    G4Mutex                        fMutex;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,63 @@
+/**
+ * @file /ECal_MT/include/GenstepRecord.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's fixed size record of an optical photon generating step.
+ * This header has no Geant4 dependency, so the ROOT macro can include it too.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef GenstepRecord_h
+#define GenstepRecord_h 1
+
+#include <cstdint>
+
+/**
+ * @brief Inputs of the scintillation and Cerenkov photons of one charged step ("genstep")
+ *
+ * Lengths are stored in mm, energies in MeV and times in ns (Geant4 units).
+ *
+ **/
+
+struct GenstepRecord
+{
+  float x, y, z;            /// pre-step point
+  float dx, dy, dz;         /// step vector, post-step point minus pre-step point
+  float time;               /// global time of the pre-step point
+  float deltaTime;          /// time of the step
+  float charge;             /// charge of the particle (eplus)
+  float preBeta, postBeta;  /// velocity of the particle at the two ends of the step (c)
+  float edep;               /// energy deposit that scintillated: visible (Birks) energy if the recording
+                            /// thread had G4EmSaturation, total deposit otherwise
+  std::int32_t material;    /// index of the material in the name list of the file header
+};
+
+static_assert(sizeof(GenstepRecord) == 52, "GenstepRecord layout must not contain padding");
+
+/**
+ * @brief Header of the genstep file (gensteps.bin)
+ *
+ * The header is followed by the material name list (a uint32 count and length-prefixed
+ * names, the index of a name is the material of a record), then by one block per event:
+ * a GenstepEventHeader and its records. Blocks of different threads are not ordered
+ * by event ID.
+ *
+ **/
+
+struct GenstepFileHeader
+{
+  char          magic[8];   /// "ECALGEN1"
+  std::uint32_t recordSize; /// sizeof(GenstepRecord) of the writer
+};
+
+struct GenstepEventHeader
+{
+  std::int32_t  eventID;
+  std::uint32_t nRecords;
+};
+
+#endif
+
+/// End of file
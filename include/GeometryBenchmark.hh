@@ -0,0 +1,39 @@
+/**
+ * @file /ECal_MT/include/GeometryBenchmark.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's benchmark of geometry optimisation and navigation.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef GeometryBenchmark_h
+#define GeometryBenchmark_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+class G4VPhysicalVolume;
+
+/**
+ * @brief Timing of the closed geometry without tracking physics
+ *
+ * The geometry is closed again (voxelisation) while time and resident memory are measured,
+ * then random points of the Tank are located and straight rays are followed through it
+ * with a private navigator.
+ *
+ **/
+
+class GeometryBenchmark
+{
+  public:
+    static G4double ResidentMemory(); /// MB, 0 if it cannot be read
+
+    static void Run(G4VPhysicalVolume* world, const G4String& label,
+                    const G4ThreeVector& center, const G4ThreeVector& halfSize, G4int nPoints);
+};
+
+#endif
+
+/// End of file
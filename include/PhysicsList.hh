@@ -36,6 +36,7 @@
 #include "G4OpRayleigh.hh"
 #include "G4OpMieHG.hh"
 #include "G4OpBoundaryProcess.hh"
+#include "G4FastSimulationManagerProcess.hh"
 
 #include "G4LossTableManager.hh"
 #include "G4EmSaturation.hh"
@@ -52,14 +53,27 @@
 #include "G4Positron.hh"
 #include "G4Proton.hh"
 #include "G4VUserPhysicsList.hh"
+#include "G4GenericMessenger.hh"
 
 
+/// Production cuts, their energy range and atomic de-excitation of a CutEx value
+
+struct CutPreset
+{
+  G4double cut;           /// range cut of gamma, e-, e+ and proton
+  G4double lowEnergyEnd;  /// lower end of the production thresholds
+  G4bool   fluo;
+  G4bool   auger;
+  G4bool   pixe;
+};
+
 class G4Cerenkov;
 class G4Scintillation;
 class G4OpAbsorption;
 class G4OpRayleigh;
 class G4OpMieHG;
 class G4OpBoundaryProcess;
+class G4FastSimulationManagerProcess;
 
 class PhysicsList: public G4VModularPhysicsList
 {
@@ -74,8 +88,15 @@ public:
   void AddPhysicsList(const G4String& name);
   
   void AddStepMax();    
+  void AddTrackKiller();
   
   virtual void SetCuts();
+  void SetCutPreset(G4int preset);
+  void BenchmarkPresets(G4int events);
+  void SetRegionCut(const G4String& regionName, G4double cut);
+
+  static const G4Cerenkov* GetCerenkovProcess() {return fCerenkovProcess;}
+  static const G4Scintillation* GetScintillationProcess() {return fScintillationProcess;}
 
 private:
 
@@ -90,8 +111,16 @@ private:
   static G4ThreadLocal G4OpRayleigh* fRayleighScatteringProcess;
   static G4ThreadLocal G4OpMieHG* fMieHGScatteringProcess;
   static G4ThreadLocal G4OpBoundaryProcess* fBoundaryProcess;
+  static G4ThreadLocal G4FastSimulationManagerProcess* fFastSimulationProcess;
     
   int scut;
+  G4double fLowEnergyEnd;
+  G4GenericMessenger* fMessenger;  /// preset commands, master only
+
+  static const CutPreset fCutPresets[];
+  static const G4int fNumberOfCutPresets;
+
+  void ApplyCutPreset();
       
   void SetBuilderList0(G4bool flagHP = false);
   void SetBuilderList1(G4bool flagHP = false);
@@ -25,6 +25,16 @@
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
 
+#include "GenstepGenerator.hh"
+#include "ExternalEventRecord.hh"
+
+#include <vector>
+
+class DetectorConstruction;
+class FiberLightTable;
+class GenstepReader;
+class ExternalEventReader;
+
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
@@ -34,11 +44,18 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     virtual void GeneratePrimaries(G4Event*);         
   
   private:
+    void GenerateLightTablePhotons(G4Event* anEvent, const FiberLightTable* table);
+    void GenerateGenstepPhotons(G4Event* anEvent, GenstepReader* reader);
+    void GenerateExternalEvent(G4Event* anEvent, ExternalEventReader* reader);
+
+    const DetectorConstruction* fDetector;
     G4ParticleGun*  fParticleGun; /// pointer for G4 gun class
     G4double fEnergy;
     G4String fParticle;
     G4int 	 fFiber;
-    G4bool 	 fBoxMuller;
+    GenstepGenerator fGenerator;             /// optical photons of the replayed gensteps
+    std::vector<GenstepRecord> fGensteps;    /// gensteps of the event
+    std::vector<ExternalParticle> fExternal; /// final state particles of the external event
 
 };
 
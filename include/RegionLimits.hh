@@ -0,0 +1,103 @@
+/**
+ * @file /ECal_MT/include/RegionLimits.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's step limits and track killing thresholds of the regions.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef RegionLimits_h
+#define RegionLimits_h 1
+
+#include "globals.hh"
+#include "G4GenericMessenger.hh"
+
+#include <utility>
+#include <vector>
+
+class G4UserLimits;
+
+/// Tracks killed by TrackKiller, each with thresholds of its own
+
+enum KillerCategory
+{
+  kKillNeutron = 0,
+  kKillFragment,            /// nuclear fragments (ions, alpha, deuteron, triton, He3)
+  kKillGamma,
+  kNumberOfKillerCategories
+};
+
+/// Kinetic energy below which and global time after which a track is killed, 0: no threshold
+
+struct KillerThreshold
+{
+  G4double energy;
+  G4double time;
+};
+
+/// Thresholds of a region ("all": every region without thresholds of its own)
+
+struct RegionKiller
+{
+  G4String region;
+  KillerThreshold threshold[kNumberOfKillerCategories];
+};
+
+/**
+ * @brief Step limits (StepMax) and killing thresholds (TrackKiller) of the regions
+ *
+ * Owned by the detector construction, which applies the limits to its regions and volumes once
+ * they are built. The settings are changed on the master only (/ECal/stepMax/, /ECal/killer/);
+ * PhysicsList reads them to register the processes, workers read the thresholds through TrackKiller.
+ *
+ **/
+
+class RegionLimits
+{
+  public:
+    RegionLimits();
+    ~RegionLimits();
+
+    static const RegionLimits* Instance() {return fInstance;}
+
+    void SetRegionStepMax(const G4String& limit);
+    void SetVolumeStepMax(const G4String& limit);
+    void SetNeutronKiller(const G4String& threshold) {AddKiller(kKillNeutron, threshold);}
+    void SetFragmentKiller(const G4String& threshold) {AddKiller(kKillFragment, threshold);}
+    void SetGammaKiller(const G4String& threshold) {AddKiller(kKillGamma, threshold);}
+
+    /// Setting the step limits of the regions and volumes just built, called by Construct
+    void Apply();
+
+    G4bool HasStepLimits() const;
+    const G4String& GetStepMaxParticles() const {return fStepMaxParticles;}
+    G4bool IsStepMaxEverywhere() const {return fStepMaxEverywhere;}
+    const std::vector<RegionKiller>& GetKillers() const {return fKillers;}
+    G4int GetKillerVersion() const {return fKillerVersion;}
+    G4bool HasKillers() const {return !fKillers.empty();}
+
+  private:
+    void AddStepLimit(std::vector<std::pair<G4String, G4double> >& limits, const G4String& limit, G4bool region);
+    void ApplyStepLimit(const G4String& name, G4double step, G4bool region);
+    void AddKiller(KillerCategory category, const G4String& threshold);
+
+    static RegionLimits* fInstance;
+
+    std::vector<std::pair<G4String, G4double> > fRegionStepMax; /// (region, maximum step) of StepMax
+    std::vector<std::pair<G4String, G4double> > fVolumeStepMax; /// (logical volume, maximum step)
+    std::vector<G4UserLimits*> fUserLimits; /// limits made for the regions and volumes
+    G4String fStepMaxParticles;   /// particles StepMax is registered for
+    G4bool fStepMaxEverywhere;    /// StepMax for every charged particle even without limits (former setup)
+    G4bool fStepMaxRegistered;    /// StepMax was registered at initialization
+    std::vector<RegionKiller> fKillers; /// thresholds of TrackKiller per region
+    G4int fKillerVersion;         /// changed with every threshold, TrackKiller reads them again
+    G4bool fApplied;              /// the geometry is built, new limits are applied at once
+    G4GenericMessenger* fStepMaxMessenger;
+    G4GenericMessenger* fKillerMessenger;
+};
+
+#endif
+
+/// End of file
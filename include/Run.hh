@@ -14,6 +14,12 @@
 
 #include "G4Run.hh"
 #include "globals.hh"
+#include "ShowerProfile.hh"
+#include "FiberLightTable.hh"
+#include "RegionLimits.hh"
+
+#include <utility>
+#include <vector>
 
 class Run : public G4Run
 {
@@ -22,7 +28,62 @@ public:
   virtual ~Run();
 
   virtual void Merge(const G4Run*);
+
+  ShowerProfile* GetProfile() {return fProfile;}
+  FiberLightTable* GetLightTable() {return fLightTable;}
+
+  void AddDetectedPhotons(G4int eventID, G4int photons);
+  G4long GetDetectedPhotons() const {return fDetectedPhotons;}
+  void AddFiberEdep(G4double edep) {fFiberEdep += edep;}
+  G4double GetFiberEdep() const {return fFiberEdep;}
+  void AddCalorimeterEdep(G4double edep) {fCalorimeterEdep += edep;}
+  G4double GetCalorimeterEdep() const {return fCalorimeterEdep;}
+  void PrintSamplingFraction(G4double cpuTime) const;
+  G4bool WriteDetectedPhotons(const G4String& fileName) const;
+
+  void CountTrappingCut(G4bool accepted) {fCutPhotons++; if (!accepted) {fCutRejected++;}}
+  void AddRejectedDetected(G4int weight) {fCutRejectedDetected += weight;}
+  void PrintTrappingCut(G4bool validation) const;
+
+  void CountEfficiency(G4bool detected) {fEfficiencyPhotons++; if (!detected) {fEfficiencyKilled++;}}
+  void PrintEfficiency(G4bool atCreation) const;
+
+  void CountThinning(G4bool kept) {fThinnedPhotons++; if (!kept) {fThinnedKilled++;}}
+  void PrintPhotonWeight(G4int weight) const;
+
+  void AddBatchTransport(G4long photons, G4long detected, G4long batches)
+  {fBatchPhotons += photons; fBatchDetected += detected; fBatches += batches;}
+  void PrintBatchTransport() const;
+
+  void CountLate(G4bool optical, G4double energy)
+  {if (optical) {fLatePhotons++;} else {fLateTracks++; fLateEnergy += energy;}}
+  void PrintTimeWindow(G4double window, G4double threshold) const;
+
+  void CountKilled(G4int category, G4double energy) {fKilled[category]++; fKilledEnergy[category] += energy;}
+  void PrintTrackKiller() const;
   
+private:
+  ShowerProfile* fProfile; /// energy deposit profiles of this thread (merged ones on master)
+  FiberLightTable* fLightTable; /// photons of the run filling the light table, 0 in other runs
+  G4long fDetectedPhotons; /// optical photons reaching the Detector in the run
+  G4double fFiberEdep;     /// energy deposit in the fiber cores in the run
+  G4double fCalorimeterEdep; /// energy deposit in the Tank and the fibers in the run
+  std::vector<std::pair<G4int, G4int> > fPhotonsPerEvent; /// (event ID, detected photons)
+  G4long fCutPhotons;          /// new optical photons seen by the trapping cut
+  G4long fCutRejected;         /// of them outside the cut
+  G4long fCutRejectedDetected; /// of them reaching the Detector (validation mode)
+  G4long fEfficiencyPhotons;   /// optical photons sampled with the photon detection efficiency
+  G4long fEfficiencyKilled;    /// of them not detected (killed)
+  G4long fThinnedPhotons;      /// Cerenkov photons seen by the thinning of the photon weight
+  G4long fThinnedKilled;       /// of them killed
+  G4long fBatchPhotons;        /// optical photons of the fiber cores transported in batches
+  G4long fBatchDetected;       /// of them reaching the Detector
+  G4long fBatches;
+  G4long fLatePhotons;         /// optical photons killed or not counted past the readout window
+  G4long fLateTracks;          /// slow tracks killed past the readout window
+  G4double fLateEnergy;        /// kinetic energy of the killed slow tracks
+  G4long fKilled[kNumberOfKillerCategories];       /// tracks killed by TrackKiller
+  G4double fKilledEnergy[kNumberOfKillerCategories]; /// their kinetic energy
 };
 
 #endif
@@ -17,6 +17,18 @@
 #include "PrimaryGeneratorAction.hh"
 #include "DetectorConstruction.hh"
 #include "Run.hh"
+#include "EventAction.hh"
+#include "SteppingAction.hh"
+#include "StepOutputService.hh"
+#include "ChannelOutput.hh"
+#include "GenstepOutput.hh"
+#include "GenstepReader.hh"
+#include "BeamProfile.hh"
+#include "EventSeeder.hh"
+#include "ExternalEventReader.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4Timer.hh"
 
 #include "G4RunManager.hh"
 #include "G4LogicalVolumeStore.hh"
@@ -27,12 +39,33 @@
 class RunAction : public G4UserRunAction
 {
   public:
-    RunAction();
+    RunAction(EventAction* eventAction = 0, SteppingAction* steppingAction = 0);
     virtual ~RunAction();
 
     virtual G4Run* GenerateRun();
     virtual void BeginOfRunAction(const G4Run*);
     virtual void EndOfRunAction(const G4Run*);
+
+  private:
+    EventAction*        fEventAction; /// owner of the step buffer on workers, 0 on master
+    SteppingAction*     fSteppingAction; /// light table and genstep steps on workers, owned here, 0 on master
+    StepOutputService*  fOutput;      /// writer of step records, owned by the master
+    ChannelOutput*      fChannels;    /// writer of per-event channel rows, owned by the master
+    GenstepOutput*      fGenstepOutput; /// writer of the optical photon generating steps, owned by the master
+    GenstepReader*      fGenstepReader; /// reader of a replay run, owned by the master
+    BeamProfile*        fBeam;        /// beam spot of the primaries, owned by the master
+    EventSeeder*        fSeeder;      /// seeds of the events, owned by the master
+    ExternalEventReader* fEventReader; /// external generator events, owned by the master
+    G4GenericMessenger* fMessenger;   /// output commands, master only
+    G4GenericMessenger* fGenstepMessenger; /// genstep commands, master only
+    G4GenericMessenger* fEventMessenger; /// external event commands, master only
+    G4bool              fLogSteps;    /// writing step records (profiles are always written)
+    G4bool              fLogChannels; /// writing channel rows
+    G4bool              fLogGensteps; /// writing gensteps
+    G4String            fReplayFile;  /// genstep file replayed instead of the gun, empty: no replay
+    G4String            fEventFile;   /// external events fired instead of the gun, empty: gun
+    G4int               fFirstEvent;  /// event of the file read by event 0 of the run
+    G4Timer             fTimer;       /// CPU time of the run (all threads) on master
 };
 
 #endif
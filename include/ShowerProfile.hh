@@ -0,0 +1,62 @@
+/**
+ * @file /ECal_MT/include/ShowerProfile.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's fixed binning accumulator of the longitudinal and lateral shower profiles.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef ShowerProfile_h
+#define ShowerProfile_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+#include <vector>
+
+/**
+ * @brief Energy deposit histograms of the Macro.cc layout, filled during the run
+ *
+ * Longitudinal: nZ bins of z from zMin to zMax (TH1D0). Lateral: nXY x nXY bins of x and y
+ * from -halfXY to halfXY (TH2D1). Entries outside the frame are dropped, as ROOT would put
+ * them in the under/overflow bins.
+ *
+ **/
+
+class ShowerProfile
+{
+  public:
+    ShowerProfile(G4int nZ, G4double zMin, G4double zMax, G4int nXY, G4double halfXY);
+
+    /// Adding the deposit of a step at its post step point
+    inline void Fill(const G4ThreeVector& position, G4double edep)
+    {
+      G4double u = (position.z() - fZMin) * fZScale;
+      if (u >= 0 && u < fNZ) { fLongitudinal[(G4int)u] += edep; }
+
+      G4double ux = (position.x() + fHalfXY) * fXYScale;
+      G4double uy = (position.y() + fHalfXY) * fXYScale;
+      if (ux >= 0 && ux < fNXY && uy >= 0 && uy < fNXY) { fLateral[(G4int)uy * fNXY + (G4int)ux] += edep; }
+    }
+
+    void Merge(const ShowerProfile& other);
+    G4bool Write(const G4String& fileName, G4long seed, G4long firstEvent, G4long events) const;
+
+  private:
+    G4int    fNZ;
+    G4double fZMin;
+    G4double fZMax;
+    G4double fZScale;   /// bins per length
+    G4int    fNXY;
+    G4double fHalfXY;
+    G4double fXYScale;
+
+    std::vector<G4double> fLongitudinal;
+    std::vector<G4double> fLateral;       /// row y, column x
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,60 @@
+/**
+ * @file /ECal_MT/include/StackingAction.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's stacking action killing optical photons which cannot reach the Detector.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "G4VUserTrackInformation.hh"
+#include "globals.hh"
+#include "DetectorConstruction.hh"
+#include "EventAction.hh"
+
+class FiberOptics;
+class FiberBatchTransport;
+class G4VProcess;
+class G4ParticleDefinition;
+
+/// Mark of a photon outside the trapping cut, tracked in the validation mode
+
+class OutsideCutInformation : public G4VUserTrackInformation
+{
+  public:
+    OutsideCutInformation() : G4VUserTrackInformation("OutsideCut") {}
+    virtual void Print() const {}
+};
+
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    StackingAction(EventAction* eventAction);
+    virtual ~StackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track);
+    virtual void PrepareNewEvent();
+
+    void FlushBatch();
+
+  private:
+    EventAction*                fEventAction;
+    const DetectorConstruction* fDetector;
+    const FiberOptics*          fOptics;
+    const G4ParticleDefinition* fOpticalPhoton;
+    G4bool                      fTableRun;    /// the run fills the light table, its primary photons are kept
+    TrappingCut                 fCut;         /// mode of the cut, read at every event
+    EfficiencyMode              fEfficiency;  /// photon detection efficiency sampled here if kEfficiencyAtCreation
+    G4int                       fWeight;      /// Cerenkov photons are kept with 1/weight probability
+    const G4VProcess*           fCerenkov;    /// Cerenkov process of this thread
+    FiberBatchTransport*        fBatch;       /// photons of the event, batch transport only
+};
+
+#endif
+
+/// End of file
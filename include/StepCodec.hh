@@ -0,0 +1,393 @@
+/**
+ * @file /ECal_MT/include/StepCodec.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's block codec of step records and its streaming block reader.
+ * This header has no Geant4 dependency, so the ROOT macro can include it too.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StepCodec_h
+#define StepCodec_h 1
+
+#include "StepRecord.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/// Codecs of a block, kStepCodecRans is applied on the output of kStepCodecVarint
+
+enum StepCodecType { kStepCodecRaw = 0, kStepCodecVarint = 1, kStepCodecRans = 2 };
+
+/**
+ * @brief Lossless codec of one block of step records
+ *
+ * Varint stage: the integer fields are stored field by field. Event and track IDs are stored as
+ * differences to the previous record, dictionary IDs as they are. The floats follow record by
+ * record as the XOR of their bits with a prediction (previous post point for the pre point,
+ * pre point for the post point, previous value for energy and time), so repeated values take
+ * a single byte.
+ * Every value is zigzag and LEB128 varint packed.
+ *
+ * Entropy stage: order-0 rANS (32 bit state, byte output, 12 bit probabilities) on the bytes
+ * of the varint stage, with the frequency table in front of the block.
+ *
+ * The encoder falls back to a simpler codec whenever it would not make the block smaller.
+ * An object keeps its work buffers, so one codec should be used per thread.
+ *
+ **/
+
+class StepCodec
+{
+  public:
+    /// Encoding n records into out, returns the codec which was used in the end
+    std::uint32_t Encode(const StepRecord* records, std::uint32_t n, std::uint32_t codec,
+                         std::vector<std::uint8_t>& out)
+    {
+      out.clear();
+      if (codec == kStepCodecRaw || n == 0)
+      {
+        out.resize(n * sizeof(StepRecord));
+        if (n > 0) { std::memcpy(&out[0], records, out.size()); }
+        return kStepCodecRaw;
+      }
+
+      std::vector<std::uint8_t>& packed = (codec == kStepCodecRans) ? fPacked : out;
+      PackVarint(records, n, packed);
+      if (packed.size() >= n * sizeof(StepRecord)) { return Encode(records, n, kStepCodecRaw, out); }
+      if (codec != kStepCodecRans) { return kStepCodecVarint; }
+
+      EncodeRans(fPacked, out);
+      if (out.size() >= fPacked.size()) { out.swap(fPacked); return kStepCodecVarint; }
+      return kStepCodecRans;
+    }
+
+    /// Decoding a block of n records, false if the data is corrupt
+    bool Decode(const std::uint8_t* data, std::size_t size, std::uint32_t codec, std::uint32_t n,
+                StepRecord* records)
+    {
+      switch (codec)
+      {
+        case kStepCodecRaw:
+          if (size != n * sizeof(StepRecord)) { return false; }
+          if (n > 0) { std::memcpy(records, data, size); }
+          return true;
+        case kStepCodecVarint:
+          return UnpackVarint(data, data + size, n, records);
+        case kStepCodecRans:
+          if (!DecodeRans(data, data + size, n * sizeof(StepRecord), fPacked)) { return false; }
+          return UnpackVarint(fPacked.data(), fPacked.data() + fPacked.size(), n, records);
+        default:
+          return false;
+      }
+    }
+
+  private:
+    static const std::uint32_t kProbBits = 12;
+    static const std::uint32_t kProbScale = 1u << kProbBits;
+    static const std::uint32_t kRansLow = 1u << 23;
+
+    static const std::size_t kIntFields = 6;
+    static const std::size_t kFields = 14;
+    static const std::size_t kPreX = 7, kPreZ = 9, kPostX = 10, kPostZ = 12;
+
+    static std::uint32_t ZigZag(std::int32_t v)   { return ((std::uint32_t)v << 1) ^ (std::uint32_t)(v >> 31); }
+    static std::int32_t  UnZigZag(std::uint32_t v) { return (std::int32_t)(v >> 1) ^ -(std::int32_t)(v & 1); }
+
+    static void PutVarint(std::vector<std::uint8_t>& out, std::uint32_t v)
+    {
+      while (v >= 0x80) { out.push_back((std::uint8_t)(v | 0x80)); v >>= 7; }
+      out.push_back((std::uint8_t)v);
+    }
+
+    static bool GetVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint32_t& v)
+    {
+      v = 0;
+      for (std::uint32_t shift = 0; shift < 35; shift += 7)
+      {
+        if (p == end) { return false; }
+        std::uint8_t byte = *p++;
+        v |= (std::uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) { return true; }
+      }
+      return false;
+    }
+
+    /// Fields of a record by index, in StepRecord order (6 integers, then 8 floats)
+    static std::uint32_t Get(const StepRecord& r, std::size_t f)
+    {
+      std::uint32_t v;
+      std::memcpy(&v, reinterpret_cast<const char*>(&r) + f * 4, 4);
+      return v;
+    }
+
+    static void Set(StepRecord& r, std::size_t f, std::uint32_t v)
+    {
+      std::memcpy(reinterpret_cast<char*>(&r) + f * 4, &v, 4);
+    }
+
+    /// Prediction of float field f of record i, records before i and fields before f are known
+    static std::uint32_t Predict(const StepRecord* records, std::size_t i, std::size_t f)
+    {
+      if (f >= kPostX && f <= kPostZ) { return Get(records[i], f - 3); }  /// post point from pre point
+      if (i == 0) { return 0; }
+      if (f >= kPreX && f <= kPreZ) { return Get(records[i - 1], f + 3); } /// pre point from previous post point
+      return Get(records[i - 1], f);                                      /// energy and time from previous value
+    }
+
+    static void PackVarint(const StepRecord* records, std::uint32_t n, std::vector<std::uint8_t>& out)
+    {
+      out.clear();
+      out.reserve(n * sizeof(StepRecord) / 2);
+      for (std::size_t f = 0; f < kIntFields; f++)
+      {
+        std::int32_t last = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+          std::int32_t v = (std::int32_t)Get(records[i], f);
+          PutVarint(out, ZigZag(f < 2 ? (std::int32_t)((std::uint32_t)v - (std::uint32_t)last) : v));
+          last = v;
+        }
+      }
+      /// floats record by record, the prediction only looks at values stored before
+      for (std::size_t i = 0; i < n; i++)
+      {
+        for (std::size_t f = kIntFields; f < kFields; f++)
+        {
+          std::uint32_t x = Get(records[i], f) ^ Predict(records, i, f);
+          PutVarint(out, (x << 1) | (x >> 31)); /// sign bit to the bottom, close values differ in low bits only
+        }
+      }
+    }
+
+    static bool UnpackVarint(const std::uint8_t* p, const std::uint8_t* end, std::uint32_t n, StepRecord* records)
+    {
+      std::uint32_t v;
+      for (std::size_t f = 0; f < kIntFields; f++)
+      {
+        std::int32_t last = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+          if (!GetVarint(p, end, v)) { return false; }
+          std::int32_t value = UnZigZag(v);
+          if (f < 2) { value = (std::int32_t)((std::uint32_t)value + (std::uint32_t)last); }
+          Set(records[i], f, (std::uint32_t)value);
+          last = value;
+        }
+      }
+      for (std::size_t i = 0; i < n; i++)
+      {
+        for (std::size_t f = kIntFields; f < kFields; f++)
+        {
+          if (!GetVarint(p, end, v)) { return false; }
+          std::uint32_t x = (v >> 1) | (v << 31);
+          Set(records[i], f, x ^ Predict(records, i, f));
+        }
+      }
+      return p == end;
+    }
+
+    /// Frequencies of the bytes scaled to kProbScale, every byte which occurs keeps at least 1
+    static void NormalizeFrequencies(const std::uint32_t* counts, std::size_t total, std::uint32_t* freqs)
+    {
+      std::uint32_t sum = 0;
+      for (std::size_t s = 0; s < 256; s++)
+      {
+        freqs[s] = counts[s] ? (std::uint32_t)((std::uint64_t)counts[s] * kProbScale / total) : 0;
+        if (counts[s] && freqs[s] == 0) { freqs[s] = 1; }
+        sum += freqs[s];
+      }
+      while (sum != kProbScale) /// the rounding error goes to the most frequent bytes
+      {
+        std::size_t largest = 0;
+        for (std::size_t s = 1; s < 256; s++) { if (freqs[s] > freqs[largest]) { largest = s; } }
+        if (sum < kProbScale) { freqs[largest]++; sum++; }
+        else { freqs[largest]--; sum--; }
+      }
+    }
+
+    /// rANS encoding: raw size, frequency table, final state, then the bytes read forward
+    static void EncodeRans(const std::vector<std::uint8_t>& in, std::vector<std::uint8_t>& out)
+    {
+      std::uint32_t counts[256] = {0};
+      for (std::size_t i = 0; i < in.size(); i++) { counts[in[i]]++; }
+
+      std::uint32_t freqs[256], starts[256];
+      NormalizeFrequencies(counts, in.size(), freqs);
+      for (std::uint32_t s = 0, cum = 0; s < 256; cum += freqs[s], s++) { starts[s] = cum; }
+
+      out.clear();
+      PutVarint(out, (std::uint32_t)in.size());
+      for (std::size_t s = 0; s < 256; s++) { PutVarint(out, freqs[s]); }
+
+      /// rANS emits bytes in reverse order, they are written from the end of a scratch buffer
+      std::vector<std::uint8_t> body(in.size() + in.size() / 2 + 16);
+      std::uint8_t* ptr = body.data() + body.size();
+      std::uint32_t x = kRansLow;
+      for (std::size_t i = in.size(); i-- > 0;)
+      {
+        std::uint32_t freq = freqs[in[i]];
+        std::uint32_t xMax = ((kRansLow >> kProbBits) << 8) * freq;
+        while (x >= xMax) { *--ptr = (std::uint8_t)x; x >>= 8; }
+        x = ((x / freq) << kProbBits) + (x % freq) + starts[in[i]];
+      }
+      ptr -= 4;
+      for (std::size_t k = 0; k < 4; k++) { ptr[k] = (std::uint8_t)(x >> (8 * k)); }
+
+      out.insert(out.end(), ptr, body.data() + body.size());
+    }
+
+    bool DecodeRans(const std::uint8_t* p, const std::uint8_t* end, std::size_t maxSize,
+                    std::vector<std::uint8_t>& out)
+    {
+      std::uint32_t size;
+      if (!GetVarint(p, end, size) || size > maxSize) { return false; }
+
+      std::uint32_t freqs[256], starts[256];
+      std::uint32_t cum = 0;
+      for (std::size_t s = 0; s < 256; s++)
+      {
+        if (!GetVarint(p, end, freqs[s]) || freqs[s] > kProbScale - cum) { return false; }
+        starts[s] = cum;
+        cum += freqs[s];
+      }
+      if (cum != kProbScale || end - p < 4) { return false; }
+
+      fSymbols.resize(kProbScale);
+      for (std::size_t s = 0; s < 256; s++)
+      {
+        std::memset(&fSymbols[starts[s]], (int)s, freqs[s]);
+      }
+
+      std::uint32_t x = 0;
+      for (std::size_t k = 0; k < 4; k++) { x |= (std::uint32_t)p[k] << (8 * k); }
+      p += 4;
+
+      out.resize(size);
+      for (std::size_t i = 0; i < size; i++)
+      {
+        std::uint32_t slot = x & (kProbScale - 1);
+        std::uint8_t s = fSymbols[slot];
+        out[i] = s;
+        x = freqs[s] * (x >> kProbBits) + slot - starts[s];
+        while (x < kRansLow)
+        {
+          if (p == end) { return false; }
+          x = (x << 8) | *p++;
+        }
+      }
+      return p == end;
+    }
+
+    std::vector<std::uint8_t> fPacked;   /// varint stage of an entropy coded block
+    std::vector<std::uint8_t> fSymbols;  /// byte of every probability slot
+};
+
+/**
+ * @brief Streaming reader of a binary step file
+ *
+ * Blocks are decoded one at a time into a caller owned vector, so the memory does not grow
+ * with the file. NextHeader walks the block headers only; ReadBlock decodes a block found that way.
+ *
+ **/
+
+class StepBlockReader
+{
+  public:
+    StepBlockReader() : fFile(0) {}
+    ~StepBlockReader() { Close(); }
+
+    /// Opening a file and reading its header and dictionary, false if it is not a step file
+    bool Open(const char* fileName)
+    {
+      Close();
+      fFile = std::fopen(fileName, "rb");
+      if (!fFile) { return false; }
+
+      StepFileHeader header;
+      if (std::fread(&header, sizeof(header), 1, fFile) != 1 ||
+          std::memcmp(header.magic, "ECALSTP4", 8) != 0 || header.recordSize != sizeof(StepRecord))
+      {
+        Close();
+        return false;
+      }
+
+      /// dictionary is kept as it is, only its length is needed
+      fDictionary.clear();
+      for (int list = 0; list < 3; list++)
+      {
+        std::uint32_t count = 0;
+        if (std::fread(&count, sizeof(count), 1, fFile) != 1) { Close(); return false; }
+        Append(&count, sizeof(count));
+        for (std::uint32_t i = 0; i < count; i++)
+        {
+          std::uint32_t length = 0;
+          if (std::fread(&length, sizeof(length), 1, fFile) != 1) { Close(); return false; }
+          Append(&length, sizeof(length));
+          std::size_t at = fDictionary.size();
+          fDictionary.resize(at + length);
+          if (length > 0 && std::fread(&fDictionary[at], 1, length, fFile) != length) { Close(); return false; }
+        }
+      }
+      return true;
+    }
+
+    void Close()
+    {
+      if (fFile) { std::fclose(fFile); }
+      fFile = 0;
+    }
+
+    const std::vector<char>& GetDictionary() const { return fDictionary; }
+
+    /// Header of the next block, its payload is skipped and its position returned in offset
+    bool NextHeader(StepBlockHeader& header, long& offset)
+    {
+      if (!fFile || std::fread(&header, sizeof(header), 1, fFile) != 1) { return false; }
+      offset = std::ftell(fFile);
+      return std::fseek(fFile, header.size, SEEK_CUR) == 0;
+    }
+
+    /// Decoding the block whose payload starts at offset
+    bool ReadBlock(const StepBlockHeader& header, long offset, std::vector<StepRecord>& records)
+    {
+      if (!fFile || std::fseek(fFile, offset, SEEK_SET) != 0) { return false; }
+      return ReadPayload(header, records);
+    }
+
+    /// Next block in file order, decoded
+    bool Next(StepBlockHeader& header, std::vector<StepRecord>& records)
+    {
+      if (!fFile || std::fread(&header, sizeof(header), 1, fFile) != 1) { return false; }
+      return ReadPayload(header, records);
+    }
+
+  private:
+    void Append(const void* data, std::size_t size)
+    {
+      const char* bytes = static_cast<const char*>(data);
+      fDictionary.insert(fDictionary.end(), bytes, bytes + size);
+    }
+
+    bool ReadPayload(const StepBlockHeader& header, std::vector<StepRecord>& records)
+    {
+      fPayload.resize(header.size);
+      if (header.size > 0 && std::fread(fPayload.data(), 1, header.size, fFile) != header.size) { return false; }
+      records.resize(header.nRecords);
+      return fCodec.Decode(fPayload.data(), fPayload.size(), header.codec, header.nRecords, records.data());
+    }
+
+    std::FILE*                fFile;
+    std::vector<char>         fDictionary;
+    std::vector<std::uint8_t> fPayload;
+    StepCodec                 fCodec;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,40 @@
+/**
+ * @file /ECal_MT/include/StepColumnWriter.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's converter from binary step records to the columnar step file.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StepColumnWriter_h
+#define StepColumnWriter_h 1
+
+#include "globals.hh"
+#include "StepColumns.hh"
+#include "StepCodec.hh"
+
+/// Geometry constants and identity of the run recorded in the columnar file header
+
+struct StepColumnGeometry
+{
+  G4int    nFiber;
+  G4double fiberPitch;
+  G4double zOffset;
+  G4double maxZ;
+  G4long   seed;
+  G4long   firstEvent;
+  G4long   runEvents;
+};
+
+class StepColumnWriter
+{
+  public:
+    static G4bool Convert(const G4String& rowFile, const G4String& columnFile,
+                          const StepColumnGeometry& geometry);
+};
+
+#endif
+
+/// End of file
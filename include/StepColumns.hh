@@ -0,0 +1,192 @@
+/**
+ * @file /ECal_MT/include/StepColumns.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's columnar step file layout and its memory mapped reader.
+ * This header has no Geant4 dependency, so the ROOT macro can include it too.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StepColumns_h
+#define StepColumns_h 1
+
+#include "StepRecord.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Header of a columnar step file (steps.col)
+ *
+ * Layout: header, nColumns StepColumnInfo, nEvents StepEventIndex, the dictionary name lists
+ * (as in the binary step file), then one array per field. Every array starts on a page
+ * boundary, so it can be mapped on its own.
+ *
+ **/
+
+struct StepColumnHeader
+{
+  char          magic[8];         /// "ECALCOL2"
+  std::uint32_t nColumns;
+  std::int32_t  nFiber;           /// number of fibers in one line
+  std::uint64_t nRecords;
+  std::uint64_t nEvents;
+  std::uint64_t indexOffset;
+  std::uint64_t dictionaryOffset;
+  std::uint64_t dictionarySize;
+  double        fiberPitch;       /// cm
+  double        zOffset;          /// cm, origin of the longitudinal profile (was 11.5 in Macro.cc)
+  double        maxZ;             /// cm, depth of the longitudinal profile (was 10.512 in Macro.cc)
+  std::int64_t  seed;             /// master seed of the run, written to profiles.dat too
+  std::int64_t  firstEvent;       /// index of event 0 of the run (EventSeeder)
+  std::int64_t  runEvents;        /// events of the run, with or without steps
+};
+
+enum StepColumnType { kStepInt32 = 0, kStepFloat32 = 1 };
+
+struct StepColumnInfo
+{
+  char          name[16];
+  std::uint32_t type;             /// StepColumnType
+  std::uint32_t size;             /// bytes per element
+  std::uint64_t offset;           /// from the start of the file
+};
+
+/// Records of an event are [first, first+count) in every column
+
+struct StepEventIndex
+{
+  std::int64_t  eventID;
+  std::uint64_t first;
+  std::uint64_t count;
+};
+
+/// Fields of StepRecord in column order
+
+struct StepColumnField
+{
+  const char*   name;
+  std::uint32_t type;
+  std::size_t   offset;
+};
+
+static const StepColumnField kStepColumnFields[] =
+{
+  {"eventID",    kStepInt32,   offsetof(StepRecord, eventID)},
+  {"trackID",    kStepInt32,   offsetof(StepRecord, trackID)},
+  {"particle",   kStepInt32,   offsetof(StepRecord, particle)},
+  {"process",    kStepInt32,   offsetof(StepRecord, process)},
+  {"preVolume",  kStepInt32,   offsetof(StepRecord, preVolume)},
+  {"postVolume", kStepInt32,   offsetof(StepRecord, postVolume)},
+  {"edep",       kStepFloat32, offsetof(StepRecord, edep)},
+  {"preX",       kStepFloat32, offsetof(StepRecord, preX)},
+  {"preY",       kStepFloat32, offsetof(StepRecord, preY)},
+  {"preZ",       kStepFloat32, offsetof(StepRecord, preZ)},
+  {"postX",      kStepFloat32, offsetof(StepRecord, postX)},
+  {"postY",      kStepFloat32, offsetof(StepRecord, postY)},
+  {"postZ",      kStepFloat32, offsetof(StepRecord, postZ)},
+  {"postTime",   kStepFloat32, offsetof(StepRecord, postTime)}
+};
+
+static const std::uint32_t kStepColumnCount = sizeof(kStepColumnFields)/sizeof(StepColumnField);
+static const std::uint64_t kStepColumnAlign = 4096;
+
+/**
+ * @brief Read-only, zero-copy view of a columnar step file
+ *
+ * The whole file is mapped once; columns and the event index are pointers into the mapping.
+ *
+ **/
+
+class StepColumnView
+{
+  public:
+    StepColumnView() : fData(0), fSize(0) {}
+    ~StepColumnView() { Close(); }
+
+    bool Open(const char* fileName)
+    {
+      Close();
+      int fd = open(fileName, O_RDONLY);
+      if (fd < 0) { return false; }
+      struct stat info;
+      if (fstat(fd, &info) != 0 || (std::size_t)info.st_size < sizeof(StepColumnHeader)) { close(fd); return false; }
+      void* data = mmap(0, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (data == MAP_FAILED) { return false; }
+      fData = static_cast<const char*>(data);
+      fSize = info.st_size;
+      if (std::memcmp(GetHeader()->magic, "ECALCOL2", 8) != 0 || !IsComplete()) { Close(); return false; }
+      return true;
+    }
+
+    void Close()
+    {
+      if (fData) { munmap(const_cast<char*>(fData), fSize); }
+      fData = 0;
+      fSize = 0;
+    }
+
+    const StepColumnHeader* GetHeader() const
+    { return reinterpret_cast<const StepColumnHeader*>(fData); }
+
+    const StepColumnInfo* GetColumnInfo() const
+    { return reinterpret_cast<const StepColumnInfo*>(fData + sizeof(StepColumnHeader)); }
+
+    const StepEventIndex* GetEvents() const
+    { return reinterpret_cast<const StepEventIndex*>(fData + GetHeader()->indexOffset); }
+
+    const char* GetDictionary() const { return fData + GetHeader()->dictionaryOffset; }
+
+    /// Pointer to the first element of a column, 0 if there is no such column
+    template <class T> const T* GetColumn(const char* name) const
+    {
+      const StepColumnInfo* info = GetColumnInfo();
+      for (std::uint32_t i = 0; i < GetHeader()->nColumns; i++)
+      {
+        if (std::strncmp(info[i].name, name, sizeof(info[i].name)) == 0 && info[i].size == sizeof(T))
+        { return reinterpret_cast<const T*>(fData + info[i].offset); }
+      }
+      return 0;
+    }
+
+  private:
+    /// True if [offset, offset+count*size) lies inside the mapping
+    bool Contains(std::uint64_t offset, std::uint64_t count, std::uint64_t size) const
+    { return offset <= fSize && (size == 0 || count <= (fSize - offset)/size); }
+
+    /// Every table and column of the header lies inside the file (a truncated file fails)
+    bool IsComplete() const
+    {
+      const StepColumnHeader* header = GetHeader();
+      if (!Contains(sizeof(StepColumnHeader), header->nColumns, sizeof(StepColumnInfo))) { return false; }
+      if (!Contains(header->indexOffset, header->nEvents, sizeof(StepEventIndex))) { return false; }
+      if (!Contains(header->dictionaryOffset, header->dictionarySize, 1)) { return false; }
+      const StepColumnInfo* info = GetColumnInfo();
+      for (std::uint32_t i = 0; i < header->nColumns; i++)
+      {
+        if (!Contains(info[i].offset, header->nRecords, info[i].size)) { return false; }
+      }
+      const StepEventIndex* events = GetEvents();
+      for (std::uint64_t e = 0; e < header->nEvents; e++)
+      {
+        if (events[e].first > header->nRecords || events[e].count > header->nRecords - events[e].first) { return false; }
+      }
+      return true;
+    }
+
+    const char* fData;
+    std::size_t fSize;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,123 @@
+/**
+ * @file /ECal_MT/include/StepDictionary.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's dictionary of particle, process and volume IDs for step records.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StepDictionary_h
+#define StepDictionary_h 1
+
+#include "globals.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+#include "G4LogicalVolume.hh"
+
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Small integer IDs for the names written in step records
+ *
+ * The name lists are built once by the master, in alphabetical order, and written to the file
+ * header. Every thread (which owns its own process objects) maps its pointers to these IDs by
+ * name, so ions created by a worker in an earlier run do not shift the IDs: a particle missing
+ * from the master list is GenericIon if it is a nucleus, "none" otherwise. ID 0 is reserved for "none".
+ *
+ **/
+
+class StepDictionary
+{
+  public:
+    static StepDictionary* Instance(); /// one dictionary per thread
+
+    static void BuildNames();          /// master, before the workers of the first run
+    void Build();
+    G4bool Write(std::FILE* file) const;
+
+    inline G4int ParticleID(const G4ParticleDefinition* particle);
+    inline G4int ProcessID(const G4VProcess* process);
+    inline G4int VolumeID(const G4LogicalVolume* volume) const;
+
+    const G4LogicalVolume* GetWorld() const {return fWorld;}
+    const G4LogicalVolume* GetDetector() const {return fDetector;}
+
+  private:
+    StepDictionary();
+
+    typedef std::unordered_map<const void*, G4int> IDMap;
+
+    typedef std::vector<std::pair<G4String, const void*> > Entries;
+
+    static G4int Lookup(const IDMap& map, const void* key);
+    static void Collect(Entries& particles, Entries& processes, Entries& volumes);
+    static void Sort(std::vector<G4String>& names, const Entries& entries);
+    static void Assign(const std::vector<G4String>& names, IDMap& map, const Entries& entries);
+
+    static G4ThreadLocal StepDictionary* fInstance;
+
+    static std::vector<G4String> fParticleNames; /// shared, written by the master only
+    static std::vector<G4String> fProcessNames;
+    static std::vector<G4String> fVolumeNames;
+
+    IDMap fParticles;
+    IDMap fProcesses;
+    IDMap fVolumes;
+
+    const G4ParticleDefinition* fLastParticle; /// tracks of the same particle come in long runs
+    G4int                       fLastParticleID;
+    const G4VProcess*           fLastProcess;
+    G4int                       fLastProcessID;
+    G4int                       fGenericIonID; /// ions created during the run share this ID
+
+    const G4LogicalVolume* fWorld;
+    const G4LogicalVolume* fDetector;
+};
+
+/// Generic lookup, 0 if the key is unknown
+
+inline G4int StepDictionary::Lookup(const IDMap& map, const void* key)
+{
+  IDMap::const_iterator it = map.find(key);
+  return (it == map.end()) ? 0 : it->second;
+}
+
+/// ID of a particle definition
+
+inline G4int StepDictionary::ParticleID(const G4ParticleDefinition* particle)
+{
+  if (particle != fLastParticle)
+  {
+    fLastParticle = particle;
+    fLastParticleID = Lookup(fParticles, particle);
+    if (fLastParticleID == 0 && particle->GetParticleType() == "nucleus") { fLastParticleID = fGenericIonID; }
+  }
+  return fLastParticleID;
+}
+
+/// ID of a (creator) process
+
+inline G4int StepDictionary::ProcessID(const G4VProcess* process)
+{
+  if (process != fLastProcess)
+  {
+    fLastProcess = process;
+    fLastProcessID = Lookup(fProcesses, process);
+  }
+  return fLastProcessID;
+}
+
+/// ID of a logical volume
+
+inline G4int StepDictionary::VolumeID(const G4LogicalVolume* volume) const
+{
+  return Lookup(fVolumes, volume);
+}
+
+#endif
+
+/// End of file
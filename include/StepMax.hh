@@ -17,6 +17,14 @@
 #include "G4ParticleDefinition.hh"
 #include "G4Step.hh"
 
+/**
+ * @brief Step limitation of the regions and logical volumes with G4UserLimits
+ *
+ * The limit of the volume of the track is used, or the limit of its region if the volume has none,
+ * and fMaxChargedStep everywhere (DBL_MAX: no limit without G4UserLimits).
+ *
+ **/
+
 class StepMax : public G4VDiscreteProcess
 {
 public:
@@ -0,0 +1,94 @@
+/**
+ * @file /ECal_MT/include/StepOutputService.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's asynchronous writer of step record blocks.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StepOutputService_h
+#define StepOutputService_h 1
+
+#include "globals.hh"
+#include "StepRecord.hh"
+#include "StepCodec.hh"
+#include "BlockQueue.hh"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/// Block of records filled by one worker thread
+
+struct StepBlock
+{
+  G4int                   thread;
+  std::uint32_t           size;
+  std::vector<StepRecord> records;
+};
+
+/**
+ * @brief Output service owned by the master run action
+ *
+ * A fixed pool of blocks bounds the memory. Workers take a free block, fill it and push it to
+ * the filled queue; a dedicated writer thread writes the filled blocks and gives them back to
+ * the free queue. If no block is free the worker waits (back-pressure) and the wait is counted.
+ * Blocks are compressed on the writer thread, so the codec costs no worker time.
+ *
+ **/
+
+class StepOutputService
+{
+  public:
+    StepOutputService(std::size_t nBlocks = 64, std::size_t blockSize = 16384);
+    ~StepOutputService();
+
+    static StepOutputService* Instance() {return fInstance;}
+
+    void Start(const G4String& fileName);
+    void Stop();
+    void Report() const;
+
+    StepBlock* Acquire();             /// called by workers
+    void Submit(StepBlock* block);    /// called by workers
+
+    const G4String& GetFileName() const {return fFileName;}
+    G4bool IsRunning() const {return fRunning.load(std::memory_order_acquire);}
+    G4bool HasFailed() const {return fFailed.load(std::memory_order_acquire);} /// a write of the run failed
+
+    void SetCodec(std::uint32_t codec) {fCodecType = codec;}  /// StepCodecType of the next run
+
+  private:
+    void WriterLoop();
+
+    static StepOutputService* fInstance;
+
+    G4String                fFileName;
+    std::vector<StepBlock>  fPool;
+    BlockQueue<StepBlock>   fFree;
+    BlockQueue<StepBlock>   fFilled;
+    std::FILE*              fFile;
+    std::thread             fWriter;
+    std::atomic<bool>       fStop;
+    std::atomic<bool>       fRunning;    /// between Start and Stop, workers record only then
+    std::atomic<bool>       fFailed;     /// a write failed (full disk), the file is incomplete
+    std::uint32_t           fCodecType;
+    StepCodec               fCodec;      /// used by the writer thread only
+    std::vector<std::uint8_t> fPayload;
+
+    std::atomic<std::uint64_t> fSubmitted;
+    std::atomic<std::uint64_t> fBytesWritten;
+    std::atomic<std::uint64_t> fRawBytes;
+    std::atomic<std::uint64_t> fEncodeNanoseconds;
+    std::atomic<std::uint64_t> fWriteNanoseconds;
+    std::atomic<std::uint64_t> fMaxDepth;
+    std::atomic<std::uint64_t> fStallNanoseconds;
+    std::atomic<std::uint64_t> fStalls;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,74 @@
+/**
+ * @file /ECal_MT/include/StepRecord.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's fixed layout binary step record.
+ * This header has no Geant4 dependency, so the ROOT macro can include it too.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StepRecord_h
+#define StepRecord_h 1
+
+#include <cstdint>
+
+/**
+ * @brief One energy depositing (or Detector reaching) step
+ *
+ * Lengths are stored in cm, energies in MeV and times in ns, as in the old "CalDat" lines.
+ *
+ **/
+
+struct StepRecord
+{
+  std::int32_t eventID;
+  std::int32_t trackID;
+  std::int32_t particle;    /// IDs of the dictionary in the file header
+  std::int32_t process;     /// creator process
+  std::int32_t preVolume;
+  std::int32_t postVolume;
+  float edep;
+  float preX, preY, preZ;
+  float postX, postY, postZ;
+  float postTime;
+};
+
+static_assert(sizeof(StepRecord) == 56, "StepRecord layout must not contain padding");
+
+/**
+ * @brief Header of the binary step file
+ *
+ * The header is followed by the particle, process and volume name lists of the dictionary
+ * (each is a uint32 count and length-prefixed names, the index of a name is its ID),
+ * then by blocks of records until the end of the file.
+ *
+ **/
+
+struct StepFileHeader
+{
+  char          magic[8];   /// "ECALSTP4"
+  std::uint32_t recordSize; /// sizeof(StepRecord) of the writer
+};
+
+/**
+ * @brief Header of a block of records
+ *
+ * Blocks of different threads are interleaved in the file, but the blocks of one thread
+ * follow each other in order, so the records of an event are contiguous per thread.
+ * The header is followed by size bytes of records encoded with the codec (see StepCodec.hh).
+ *
+ **/
+
+struct StepBlockHeader
+{
+  std::int32_t  thread;
+  std::uint32_t nRecords;
+  std::uint32_t codec;      /// StepCodecType
+  std::uint32_t size;       /// bytes of the encoded records
+};
+
+#endif
+
+/// End of file
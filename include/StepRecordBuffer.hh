@@ -0,0 +1,50 @@
+/**
+ * @file /ECal_MT/include/StepRecordBuffer.hh
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's thread local buffer of binary step records.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef StepRecordBuffer_h
+#define StepRecordBuffer_h 1
+
+#include "globals.hh"
+#include "StepRecord.hh"
+#include "StepOutputService.hh"
+
+class StepRecordBuffer
+{
+  public:
+    StepRecordBuffer(G4int threadID);
+    ~StepRecordBuffer();
+
+    /// Appending one record, the block is handed to the writer thread when it is full
+    inline void Append(const StepRecord& record)
+    {
+      if (!fBlock && !Acquire()) { return; }
+      fBlock->records[fBlock->size++] = record;
+      if (fBlock->size == fBlock->records.size()) { Flush(); }
+    }
+
+    void Flush();
+
+    /// True if step records are written in this run
+    static G4bool IsEnabled()
+    {
+      StepOutputService* service = StepOutputService::Instance();
+      return service && service->IsRunning();
+    }
+
+  private:
+    G4bool Acquire();
+
+    G4int      fThreadID;
+    StepBlock* fBlock;  /// block being filled, 0 between flushes
+};
+
+#endif
+
+/// End of file
@@ -15,15 +15,21 @@
 #include "G4UserSteppingAction.hh"
 #include "globals.hh"
 #include "EventAction.hh"
+#include "StepDictionary.hh"
+#include "DetectorConstruction.hh"
 
 #include "G4Step.hh"
 #include "G4Event.hh"
 #include "G4RunManager.hh"
 #include "G4LogicalVolume.hh"
+#include "G4VProcess.hh"
 #include "G4SystemOfUnits.hh"
 
 #include "Run.hh"
 #include <cmath>
+#include <vector>
+
+class G4Material;
 
 class SteppingAction : public G4UserSteppingAction
 {
@@ -32,9 +38,16 @@ class SteppingAction : public G4UserSteppingAction
     virtual ~SteppingAction();
 
     virtual void UserSteppingAction(const G4Step*); /// method from the base class
+
+    static G4bool IsNeeded(const DetectorConstruction* detector);
   private:
+    void FillLightTable(const G4Step* step, FiberLightTable* table);
+    void RecordGenstep(const G4Step* step);
+    G4bool IsOpticalMaterial(const G4Material* material);
+
     EventAction*  fEventAction;
-    G4bool fLite;
+    StepDictionary* fDictionary; /// pointer to ID lookups of this thread
+    std::vector<G4int> fOpticalMaterial; /// material index -> makes optical photons (1), not (0), unknown (-1)
 };
 
 #endif
@@ -0,0 +1,79 @@
+/**
+ * @file /ECal_MT/include/TrackKiller.hh
+ * @date 2026/10/16 <creation>
+ * 
+ * @section DESCRIPTION
+ * 
+ * The Geant4 simulation of ECal's TrackKiller class for killing slow and late tracks per region.
+ * Latest updates of project can be found in README file.
+ **/
+
+#ifndef TrackKiller_h
+#define TrackKiller_h 1
+
+#include "globals.hh"
+#include "G4VDiscreteProcess.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Step.hh"
+#include "RegionLimits.hh"
+#include "DetectorConstruction.hh"
+
+#include <utility>
+#include <vector>
+
+class G4Region;
+
+/**
+ * @brief Killing neutrons, nuclear fragments and gammas below a kinetic energy or after a global time
+ *
+ * The thresholds belong to the region of the track (/ECal/killer/), as G4NeutronKiller does for
+ * the whole world. Killed tracks are counted in the Run; nuclear fragments deposit their kinetic
+ * energy on the spot (their range is negligible), neutrons and gammas take it away.
+ * Every particle is also stopped past the readout window (DetectorConstruction::IsLate) and a
+ * secondary as soon as it is in the World, so no user code runs on the steps for these kills.
+ * Optical photons get the process only if a readout window is set before initialization.
+ *
+ **/
+
+class TrackKiller : public G4VDiscreteProcess
+{
+public:
+  TrackKiller(const RegionLimits* limits, const DetectorConstruction* detector,
+              const G4String& processName = "TrackKiller");
+  virtual ~TrackKiller();
+
+  virtual G4bool IsApplicable(const G4ParticleDefinition&);
+
+  virtual G4double
+  PostStepGetPhysicalInteractionLength(const G4Track& track,
+                                       G4double previousStepSize,
+                                       G4ForceCondition* condition);
+
+  virtual G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&);
+
+  virtual G4double GetMeanFreePath(const G4Track&,G4double,G4ForceCondition*)
+  {return DBL_MAX;};
+
+  static G4int Category(const G4ParticleDefinition* particle); /// KillerCategory, -1: not killed
+
+private:
+  const KillerThreshold* Find(const G4Region* region, G4int category);
+
+  /// A secondary in the World (depth 0 of its touchable) has left the calorimeter
+  G4bool IsEscaped(const G4Track& track) const
+  { return track.GetParentID() > 0 && track.GetTouchable()->GetHistoryDepth() == 0; }
+
+  G4bool IsLate(const G4Track& track) const
+  { return fDetector->IsLate(track.GetGlobalTime(), track.GetDefinition() == fOpticalPhoton, track.GetKineticEnergy()); }
+
+  const RegionLimits* fLimits;
+  const DetectorConstruction* fDetector; /// readout window
+  const G4ParticleDefinition* fOpticalPhoton;
+  G4int fVersion;                 /// thresholds of fLimits read last
+  const RegionKiller* fAll;       /// thresholds of "all"
+  std::vector<std::pair<const G4Region*, const RegionKiller*> > fRegions;
+};
+
+#endif
+
+/// End of file
@@ -0,0 +1,47 @@
+/**
+ * @file /ECal_MT/src/AbsorberSD.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's sensitive detector source code of the tungsten absorber and the fiber claddings.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "AbsorberSD.hh"
+#include "EventAction.hh"
+#include "G4Step.hh"
+#include "G4EventManager.hh"
+
+/**
+ * @brief Constructor of Absorber SD
+ *
+ * @param name 	Name of the sensitive detector
+ *
+ **/
+
+AbsorberSD::AbsorberSD(const G4String& name)
+: G4VSensitiveDetector(name), fEventAction(0)
+{}
+
+/// @brief Destructor of Absorber SD
+
+AbsorberSD::~AbsorberSD()
+{}
+
+/// @brief Start of an event
+
+void AbsorberSD::Initialize(G4HCofThisEvent*)
+{
+  fEventAction = static_cast<EventAction*>(G4EventManager::GetEventManager()->GetUserEventAction());
+}
+
+/// @brief Scoring a step of the absorber or of a cladding, the last steps of stopping tracks included
+
+G4bool AbsorberSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  fEventAction->ScoreStep(step);
+  return false;
+}
+
+/// End of file
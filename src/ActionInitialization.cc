@@ -44,12 +44,14 @@ void ActionInitialization::Build() const
 {
   
   SetUserAction(new PrimaryGeneratorAction(fEnergy,fParticle, fFiber));
-  SetUserAction(new RunAction());
   
   EventAction* eventAction = new EventAction();
+  SetUserAction(new RunAction(eventAction, new SteppingAction(eventAction))); /// installed by the run action when needed
   SetUserAction(eventAction);
   
-  SetUserAction(new SteppingAction(eventAction));
+  StackingAction* stackingAction = new StackingAction(eventAction);
+  eventAction->SetStackingAction(stackingAction);
+  SetUserAction(stackingAction);
 }  
 
 /// End of file
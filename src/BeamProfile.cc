@@ -0,0 +1,125 @@
+/**
+ * @file /ECal_MT/src/BeamProfile.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's beam spot and angular spread of the primary particle.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "BeamProfile.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include <cmath>
+
+BeamProfile* BeamProfile::fInstance = 0;
+
+/**
+ * @brief Constructor of Beam profile
+ *
+ * @param fiber 	Fiber number parameter
+ * @param pitch 	Distance of fiber centers
+ * @param fRadius 	0.87*(fiber/2) fiber pitches, the radius of the former beam spot
+ * @param fHalfWidth 	Half width of the fiber grid
+ *
+ **/
+
+BeamProfile::BeamProfile(G4int fiber, G4double pitch)
+: fShape(kBeamDisk), fRadius(0.87*(fiber/2)*pitch), fSigma(pitch), fHalfWidth(fiber*pitch/2),
+  fDivergence(0.), fMessenger(0)
+{
+  fInstance = this;
+
+  fMessenger = new G4GenericMessenger(this, "/ECal/beam/", "Beam profile of the primary particle");
+  fMessenger->DeclareMethod("shape", &BeamProfile::SetShape)
+    .SetGuidance("Beam spot: disk (uniform, radius), gaussian (sigma in x and y),")
+    .SetGuidance("square (uniform over the face of the fiber grid) or point (origin)")
+    .SetParameterName("shape", false)
+    .SetCandidates("disk gaussian square point")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fMessenger->DeclarePropertyWithUnit("radius", "mm", fRadius)
+    .SetGuidance("Radius of the disk beam spot")
+    .SetParameterName("radius", false)
+    .SetRange("radius >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fMessenger->DeclarePropertyWithUnit("sigma", "mm", fSigma)
+    .SetGuidance("Standard deviation of the Gaussian beam spot in x and y")
+    .SetParameterName("sigma", false)
+    .SetRange("sigma >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fMessenger->DeclarePropertyWithUnit("divergence", "mrad", fDivergence)
+    .SetGuidance("Standard deviation of the angle of the primary to the +z axis in the xz and in the yz plane (0: parallel beam)")
+    .SetParameterName("divergence", false)
+    .SetRange("divergence >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+/// @brief Destructor of Beam profile
+
+BeamProfile::~BeamProfile()
+{
+  delete fMessenger;
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/// @brief Selecting the shape of the beam spot
+
+void BeamProfile::SetShape(const G4String& shape)
+{
+  if (shape == "gaussian") { fShape = kBeamGaussian; }
+  else if (shape == "square") { fShape = kBeamSquare; }
+  else if (shape == "point") { fShape = kBeamPoint; }
+  else { fShape = kBeamDisk; }
+}
+
+/**
+ * @brief Sampling the start of a primary with the engine of the calling thread
+ *
+ * @param position 		Point of the beam spot in the z = 0 plane
+ * @param direction 	Direction, +z turned by the divergence
+ *
+ **/
+
+void BeamProfile::Sample(G4ThreeVector& position, G4ThreeVector& direction) const
+{
+  G4double x = 0., y = 0.;
+  switch (fShape)
+  {
+    case kBeamDisk:
+    {
+      G4double r = fRadius * std::sqrt(G4UniformRand()), phi = twopi * G4UniformRand();
+      x = r * std::cos(phi);
+      y = r * std::sin(phi);
+      break;
+    }
+    case kBeamGaussian:
+      x = G4RandGauss::shoot(0., fSigma);
+      y = G4RandGauss::shoot(0., fSigma);
+      break;
+    case kBeamSquare:
+      x = fHalfWidth * (2 * G4UniformRand() - 1);
+      y = fHalfWidth * (2 * G4UniformRand() - 1);
+      break;
+    case kBeamPoint:
+      break;
+  }
+  position.set(x, y, 0.);
+
+  direction.set(0., 0., 1.);
+  if (fDivergence > 0)
+  {
+    /// independent projected angles, so the spot at any depth is Gaussian in x and y
+    G4double thetaX = G4RandGauss::shoot(0., fDivergence), thetaY = G4RandGauss::shoot(0., fDivergence);
+    direction.set(std::tan(thetaX), std::tan(thetaY), 1.);
+    direction = direction.unit();
+  }
+}
+
+/// End of file
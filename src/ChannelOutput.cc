@@ -0,0 +1,101 @@
+/**
+ * @file /ECal_MT/src/ChannelOutput.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's writer of the per-event channel rows.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "ChannelOutput.hh"
+#include "G4AutoLock.hh"
+
+#include <cstring>
+
+ChannelOutput* ChannelOutput::fInstance = 0;
+
+/// @brief Constructor of Channel output
+
+ChannelOutput::ChannelOutput()
+: fFile(0), fChannels(0), fRows(0), fRunning(false)
+{
+  fInstance = this;
+}
+
+/// @brief Destructor of Channel output
+
+ChannelOutput::~ChannelOutput()
+{
+  Stop();
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/**
+ * @brief Opening the channel file of a run
+ *
+ * @param fileName 	Name of the file
+ * @param nFiber 	Number of fibers in one line, there are nFiber^2 channels
+ *
+ **/
+
+void ChannelOutput::Start(const G4String& fileName, G4int nFiber)
+{
+  Stop();
+
+  fFileName = fileName;
+  fFile = std::fopen(fFileName.c_str(), "wb");
+  if (!fFile)
+  {
+    G4Exception("ChannelOutput::Start()", "ECal003", FatalException,
+                ("Cannot open " + fFileName).c_str());
+    return;
+  }
+
+  ChannelFileHeader header;
+  std::memcpy(header.magic, "ECALCHN1", sizeof(header.magic));
+  header.nChannels = nFiber * nFiber;
+  header.nFiber = nFiber;
+  std::fwrite(&header, sizeof(header), 1, fFile);
+
+  fChannels = header.nChannels;
+  fRows = 0;
+  fRunning.store(true, std::memory_order_release);
+}
+
+/// @brief Closing the file after the last event of the run
+
+void ChannelOutput::Stop()
+{
+  if (!fFile) { return; }
+
+  fRunning.store(false, std::memory_order_release);
+  std::fclose(fFile);
+  fFile = 0;
+
+  G4cout << G4endl << " Channel output (" << fFileName << "): " << fRows << " events of "
+         << fChannels << " channels" << G4endl;
+}
+
+/**
+ * @brief Writing the row of an event
+ *
+ * @param eventID 	ID of the event
+ * @param edep 		Energy deposit per channel in MeV
+ * @param photons 	Detected photons per channel
+ *
+ **/
+
+void ChannelOutput::WriteRow(G4int eventID, const float* edep, const std::int32_t* photons)
+{
+  G4AutoLock lock(&fMutex);
+  if (!fFile) { return; }
+
+  std::int32_t id = eventID;
+  std::fwrite(&id, sizeof(id), 1, fFile);
+  std::fwrite(edep, sizeof(float), fChannels, fFile);
+  std::fwrite(photons, sizeof(std::int32_t), fChannels, fFile);
+  fRows++;
+}
+
+/// End of file
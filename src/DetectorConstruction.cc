@@ -16,23 +16,444 @@
 #include "G4LogicalBorderSurface.hh"
 #include "G4LogicalSkinSurface.hh"
 #include "G4OpticalSurface.hh"
+#include "G4SDManager.hh"
+#include "G4MultiFunctionalDetector.hh"
+#include "G4PSEnergyDeposit.hh"
+#include "FiberSD.hh"
+#include "DetectorSD.hh"
+#include "AbsorberSD.hh"
+#include "FiberParameterisation.hh"
+#include "GeometryBenchmark.hh"
+#include "FiberBatchTransport.hh"
+#include "FiberOptics.hh"
+#include "FiberOpticsModel.hh"
+#include "FiberLightTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "RegionLimits.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PVReplica.hh"
+#include "G4PVParameterised.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4Timer.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
 
 
 /** @brief Constructor of Detector construction
  * 
  *  @param fCalSim	Option to select between authentication and calorimeter layouts
  *  @param fiber 	Fiber number parameter
+ *  @param fPitch 	Distance of fiber centers (size of tank per fiber)
+ *  @param fProfileOrigin, fProfileDepth	Frame of the longitudinal profile used by the analysis
+ *  @param fPlacement 	Way of building the fiber grid (/ECal/geometry/fiberPlacement)
+ *  @param fTransport 	Transport of the optical photons in the fibers (/ECal/optics/fiberTransport)
+ *  @param fLightTablePhotons 	Photons tracked to fill the light table (/ECal/optics/tablePhotons)
+ *  @param fTrappingCut 	Killing of optical photons outside the acceptance (/ECal/optics/trappingCut)
+ *  @param fEfficiencyMode 	Where the photon detection efficiency is sampled (/ECal/optics/efficiency)
+ *  @param fPhotonWeight 	Weight of the generated optical photons (/ECal/optics/photonWeight)
+ *  @param fTimeWindow, fLateEnergyThreshold 	Readout window and the slow tracks killed after it (/ECal/optics/timeWindow)
+ *  @param fAbsorberCut, fFiberCut, fPhotodetectorCut 	Production cuts of the regions (/ECal/cuts/), 0: default cut
+ *  @param fScoreShower 	Steps of the tungsten and claddings fill the profiles and step records (/ECal/scoring/shower)
+ *  @param fLimits 	Step limits and killing thresholds of the regions (/ECal/stepMax/, /ECal/killer/)
  * 
  **/
 
 DetectorConstruction::DetectorConstruction(G4int fiber)
-: G4VUserDetectorConstruction(), fFiber(fiber), fCalSim(true)
-{}
+: G4VUserDetectorConstruction(), fFiber(fiber), fCalSim(true),
+  fPitch(1.0*mm), fProfileOrigin(11.5*cm), fProfileDepth(10.512*cm),
+  fPlacement(kFiberPlacement), fTransport(kFiberTransportFull), fTrappingCut(kTrappingCutOn),
+  fEfficiencyMode(kEfficiencyOff), fOptics(0),
+  fLightTable(0), fLightTablePhotons(2000000), fFillingTable(false), fPhotonWeight(1),
+  fTimeWindow(0.), fLateEnergyThreshold(0.), fAbsorberCut(0.), fFiberCut(0.), fPhotodetectorCut(0.),
+  fScoreShower(true), fLimits(0), fWorld(0), fTank(0), fMessenger(0), fOpticsMessenger(0), fCutsMessenger(0),
+  fScoringMessenger(0)
+{
+  fMessenger = new G4GenericMessenger(this, "/ECal/geometry/", "Geometry of the calorimeter");
+  fMessenger->DeclareMethod("fiberPlacement", &DetectorConstruction::SetFiberPlacement)
+    .SetGuidance("Building of the fiber grid: placement (2*fiber^2 volumes), replica or parameterised")
+    .SetParameterName("placement", false)
+    .SetCandidates("placement replica parameterised")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fMessenger->DeclareMethod("benchmark", &DetectorConstruction::Benchmark)
+    .SetGuidance("Voxelisation time and memory, point location and ray stepping time in the Tank")
+    .SetParameterName("points", true)
+    .SetDefaultValue("100000")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fOpticsMessenger = new G4GenericMessenger(this, "/ECal/optics/", "Optical photons");
+  fOpticsMessenger->DeclareMethod("fiberTransport", &DetectorConstruction::SetFiberTransport)
+    .SetGuidance("Optical photons in the fibers: full (tracked to every reflection), fast (FiberOpticsModel)")
+    .SetGuidance("or table (FiberLightTable filled once with full tracking and kept in a cache file)")
+    .SetGuidance("or batch (photons of an event are collected and transported together, FiberBatchTransport)")
+    .SetParameterName("transport", false)
+    .SetCandidates("full fast table batch")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclareMethod("checkBatch", &DetectorConstruction::CheckBatchTransport)
+    .SetGuidance("Compare the batch transport with the fast transport on random photons of one fiber core")
+    .SetParameterName("photons", true)
+    .SetDefaultValue("200000")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclareMethod("trappingCut", &DetectorConstruction::SetTrappingCut)
+    .SetGuidance("Optical photons which cannot reach the Detector are killed at creation (on),")
+    .SetGuidance("tracked (off) or tracked and counted at the Detector (validate)")
+    .SetParameterName("cut", false)
+    .SetCandidates("on off validate")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclareMethod("efficiency", &DetectorConstruction::SetEfficiencyMode)
+    .SetGuidance("Photon detection efficiency of the Detector: off, sampled at the creation of the photon")
+    .SetGuidance("(undetectable photons are not tracked) or at its arrival to the Detector")
+    .SetParameterName("mode", false)
+    .SetCandidates("off creation detector")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclareMethod("efficiencyCurve", &DetectorConstruction::SetEfficiencyCurve)
+    .SetGuidance("Efficiency curve as pairs of photon energy (eV) and efficiency (0-1), energies increasing,")
+    .SetGuidance("linear between the points and constant beyond the ends, e.g. 2.0 0.10 3.0 0.25 5.06 0.20")
+    .SetParameterName("curve", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclareProperty("tablePhotons", fLightTablePhotons)
+    .SetGuidance("Optical photons tracked to fill the light table when no cache file matches")
+    .SetParameterName("photons", false)
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclareMethod("fillTable", &DetectorConstruction::FillFiberLightTable)
+    .SetGuidance("Fill the fiber light table with full optical tracking of tablePhotons photons")
+    .SetGuidance("unless a cache file matches (table transport); a run started before it fills the table instead")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclareProperty("photonWeight", fPhotonWeight)
+    .SetGuidance("Only 1/weight of the scintillation and Cerenkov photons is generated, every detected")
+    .SetGuidance("photon is counted with the weight (1: no biasing)")
+    .SetParameterName("weight", false)
+    .SetRange("weight >= 1")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclarePropertyWithUnit("timeWindow", "ns", fTimeWindow)
+    .SetGuidance("Readout integration window: optical photons are killed once their global time passes it")
+    .SetGuidance("(in flight only if it is set before initialization) and photons reaching the Detector")
+    .SetGuidance("later are not counted (0: no window)")
+    .SetParameterName("window", false)
+    .SetRange("window >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fOpticsMessenger->DeclarePropertyWithUnit("lateEnergyThreshold", "MeV", fLateEnergyThreshold)
+    .SetGuidance("Other tracks below this kinetic energy are killed past the readout window as well")
+    .SetGuidance("(slow neutrons and their products, 0: optical photons only)")
+    .SetParameterName("energy", false)
+    .SetRange("energy >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fCutsMessenger = new G4GenericMessenger(this, "/ECal/cuts/", "Production cuts of the regions");
+  fCutsMessenger->DeclareMethodWithUnit("absorber", "mm", &DetectorConstruction::SetAbsorberCut)
+    .SetGuidance("Production cut of gamma, e-, e+ and proton in the tungsten of the Tank (0: default cut)")
+    .SetParameterName("cut", false)
+    .SetRange("cut >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fCutsMessenger->DeclareMethodWithUnit("fibers", "mm", &DetectorConstruction::SetFiberCut)
+    .SetGuidance("Production cut of gamma, e-, e+ and proton in the fibers (0: default cut)")
+    .SetParameterName("cut", false)
+    .SetRange("cut >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fCutsMessenger->DeclareMethodWithUnit("photodetector", "mm", &DetectorConstruction::SetPhotodetectorCut)
+    .SetGuidance("Production cut of gamma, e-, e+ and proton in the Detector (0: default cut)")
+    .SetParameterName("cut", false)
+    .SetRange("cut >= 0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fScoringMessenger = new G4GenericMessenger(this, "/ECal/scoring/", "Scoring of the calorimeter");
+  fScoringMessenger->DeclareProperty("shower", fScoreShower)
+    .SetGuidance("Score every step of the tungsten and the claddings for the shower profiles (profiles.dat)")
+    .SetGuidance("and the step records (steps.col); false leaves only the fiber and Detector readout, whose")
+    .SetGuidance("steps are scored only with it as well. The calorimeter deposit is scored either way.")
+    .SetParameterName("shower", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  fLimits = new RegionLimits();
+}
 
 /// @brief Destructor of Detector construction
 
 DetectorConstruction::~DetectorConstruction()
-{ }
+{
+  delete fMessenger;
+  delete fOpticsMessenger;
+  delete fCutsMessenger;
+  delete fScoringMessenger;
+  delete fLimits;
+  delete fOptics;
+  delete fLightTable;
+}
+
+/// @brief Selecting the way of building the fiber grid (before initialization)
+
+void DetectorConstruction::SetFiberPlacement(const G4String& placement)
+{
+  if (placement == "replica") { fPlacement = kFiberReplica; }
+  else if (placement == "parameterised") { fPlacement = kFiberParameterised; }
+  else { fPlacement = kFiberPlacement; }
+}
+
+/// @brief Selecting the transport of the optical photons in the fibers (before initialization)
+
+void DetectorConstruction::SetFiberTransport(const G4String& transport)
+{
+  if (transport == "fast") { fTransport = kFiberTransportFast; }
+  else if (transport == "table") { fTransport = kFiberTransportTable; }
+  else if (transport == "batch") { fTransport = kFiberTransportBatch; }
+  else { fTransport = kFiberTransportFull; }
+}
+
+/// @brief Selecting the trapping cut of new optical photons (used from the next event)
+
+void DetectorConstruction::SetTrappingCut(const G4String& cut)
+{
+  if (cut == "off") { fTrappingCut = kTrappingCutOff; }
+  else if (cut == "validate") { fTrappingCut = kTrappingCutValidate; }
+  else { fTrappingCut = kTrappingCutOn; }
+}
+
+/// @brief Selecting where the photon detection efficiency is applied (used from the next event)
+
+void DetectorConstruction::SetEfficiencyMode(const G4String& mode)
+{
+  if (mode == "creation") { fEfficiencyMode = kEfficiencyAtCreation; }
+  else if (mode == "detector") { fEfficiencyMode = kEfficiencyAtDetector; }
+  else { fEfficiencyMode = kEfficiencyOff; }
+}
+
+/// @brief Production cut of the tungsten, PhysicsList::SetCuts applies it at initialization
+
+void DetectorConstruction::SetAbsorberCut(G4double cut)
+{
+  fAbsorberCut = cut;
+  ApplyRegionCut("Absorber", cut);
+}
+
+/// @brief Production cut of the fibers
+
+void DetectorConstruction::SetFiberCut(G4double cut)
+{
+  fFiberCut = cut;
+  ApplyRegionCut("Fibers", cut);
+}
+
+/// @brief Production cut of the Detector
+
+void DetectorConstruction::SetPhotodetectorCut(G4double cut)
+{
+  fPhotodetectorCut = cut;
+  ApplyRegionCut("Photodetector", cut);
+}
+
+/**
+ * @brief Changing the production cuts of a region between runs
+ *
+ * Before initialization the region has no cuts of its own yet, PhysicsList::SetCuts gives them.
+ * The energy thresholds of the changed cuts are rebuilt at the next run.
+ *
+ * @param regionName 	Name of the region
+ * @param cut 			Range cut of gamma, e-, e+ and proton, 0: the default cuts
+ *
+ **/
+
+void DetectorConstruction::ApplyRegionCut(const G4String& regionName, G4double cut)
+{
+  G4Region* region = G4RegionStore::GetInstance()->GetRegion(regionName, false);
+  G4ProductionCuts* defaults = G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+  if (!region || !region->GetProductionCuts() || region->GetProductionCuts() == defaults) { return; }
+
+  for (G4int i = 0; i < NumberOfG4CutIndex; i++)
+  {
+    region->GetProductionCuts()->SetProductionCut(cut > 0 ? cut : defaults->GetProductionCut(i), i);
+  }
+  G4RunManager::GetRunManager()->PhysicsHasBeenModified();
+}
+
+/// @brief Printing the electron production cut of the regions in the current run
+
+void DetectorConstruction::PrintRegionCuts() const
+{
+  static const char* regions[] = { "Absorber", "Fibers", "Photodetector" };
+  G4cout << " Production cuts (e-):";
+  for (G4int i = 0; i < 3; i++)
+  {
+    G4Region* region = G4RegionStore::GetInstance()->GetRegion(regions[i], false);
+    if (!region || !region->GetProductionCuts()) { continue; }
+    G4cout << " " << regions[i] << " " << region->GetProductionCuts()->GetProductionCut("e-") / mm << " mm";
+  }
+  G4cout << G4endl;
+}
+
+/**
+ * @brief Reading the photon detection efficiency curve
+ *
+ * @param curve 	Pairs of photon energy in eV and efficiency, energies increasing
+ *
+ **/
+
+void DetectorConstruction::SetEfficiencyCurve(const G4String& curve)
+{
+  std::vector<G4double> numbers, energies, values;
+  std::istringstream in(curve);
+  G4double number;
+  while (in >> number) { numbers.push_back(number); }
+
+  G4bool valid = in.eof() && !numbers.empty() && numbers.size() % 2 == 0; /// no trailing energy without efficiency
+  for (std::size_t i = 0; valid && i < numbers.size(); i += 2)
+  {
+    G4double energy = numbers[i]*eV, value = numbers[i+1];
+    valid = (energies.empty() || energy > energies.back()) && value >= 0 && value <= 1;
+    energies.push_back(energy);
+    values.push_back(value);
+  }
+
+  if (!valid)
+  {
+    G4ExceptionDescription description;
+    description << "Efficiency curve \"" << curve << "\" is not a list of (energy in eV, efficiency 0-1)"
+                << " pairs of increasing energies, the curve is not changed.";
+    G4Exception("DetectorConstruction::SetEfficiencyCurve()", "ECal004", JustWarning, description);
+    return;
+  }
+  fEfficiencyEnergy.swap(energies);
+  fEfficiencyValue.swap(values);
+}
+
+/// @brief Photon detection efficiency at a photon energy, 1 without a curve
+
+G4double DetectorConstruction::GetDetectionEfficiency(G4double energy) const
+{
+  if (fEfficiencyEnergy.empty()) { return 1.; }
+  std::size_t i = std::upper_bound(fEfficiencyEnergy.begin(), fEfficiencyEnergy.end(), energy) - fEfficiencyEnergy.begin();
+  if (i == 0) { return fEfficiencyValue.front(); }
+  if (i == fEfficiencyEnergy.size()) { return fEfficiencyValue.back(); }
+  G4double f = (energy - fEfficiencyEnergy[i-1]) / (fEfficiencyEnergy[i] - fEfficiencyEnergy[i-1]);
+  return fEfficiencyValue[i-1] + f * (fEfficiencyValue[i] - fEfficiencyValue[i-1]);
+}
+
+/**
+ * @brief Grid cell of a point, the grid is the same in every layout
+ *
+ * @param position 	Global point
+ * @param x, y 		Point relative to the center of the Tank
+ * @param i, j 		Cell indices, the fiber of copy number i*fFiber+j for 0 <= i, j < fFiber
+ *
+ **/
+
+void DetectorConstruction::ToGridCell(const G4ThreeVector& position, G4double& x, G4double& y,
+                                      G4double& i, G4double& j) const
+{
+  G4double half = fFiber / 2.;
+  x = position.x() - fTankCenter.x();
+  y = position.y() - fTankCenter.y();
+  i = std::floor(x / fPitch + half);
+  j = std::floor(y / fPitch + half);
+}
+
+/// @brief Point in the frame of the fiber under it (FiberOptics coordinates)
+
+G4ThreeVector DetectorConstruction::ToFiberFrame(const G4ThreeVector& position) const
+{
+  G4double half = fFiber / 2., x, y, i, j;
+  ToGridCell(position, x, y, i, j);
+  return G4ThreeVector(x - (i + 0.5 - half) * fPitch, y - (j + 0.5 - half) * fPitch, position.z() - fTankCenter.z());
+}
+
+/// @brief Readout channel of the fiber in front of a point, the edge fibers take the points beyond the grid
+
+G4int DetectorConstruction::GetChannel(const G4ThreeVector& position) const
+{
+  G4double x, y, i, j;
+  ToGridCell(position, x, y, i, j);
+  G4int ci = std::min(std::max((G4int)i, 0), fFiber - 1);
+  G4int cj = std::min(std::max((G4int)j, 0), fFiber - 1);
+  return ci * fFiber + cj;
+}
+
+/// @brief True if the table transport is selected and no cache file has filled the table
+
+G4bool DetectorConstruction::NeedsFiberLightTable() const
+{
+  return fLightTable && fLightTable->IsEmpty();
+}
+
+/**
+ * @brief Filling the empty fiber light table by runs of isotropic photons in one fiber
+ *
+ * Nothing is done if the transport has no table or the cache file has been loaded.
+ *
+ **/
+
+void DetectorConstruction::FillFiberLightTable()
+{
+  if (!NeedsFiberLightTable()) { return; }
+
+  fFillingTable = true;
+  G4RunManager::GetRunManager()->BeamOn((fLightTablePhotons + kFiberLightPhotonsPerEvent - 1)
+                                        / kFiberLightPhotonsPerEvent);
+  fFillingTable = false;
+}
+
+/**
+ * @brief Benchmark of the constructed geometry
+ *
+ * @param nPoints 	Number of random points and rays in the Tank
+ *
+ **/
+
+void DetectorConstruction::Benchmark(G4int nPoints)
+{
+  if (!fWorld) { return; }
+
+  static const char* names[] = { "placement", "replica", "parameterised" };
+  const G4Box* tank = static_cast<const G4Box*>(fTank->GetLogicalVolume()->GetSolid());
+  GeometryBenchmark::Run(fWorld, G4String(names[fPlacement]) + " fibers " + std::to_string(fFiber),
+                         fTank->GetTranslation(),
+                         G4ThreeVector(tank->GetXHalfLength(), tank->GetYHalfLength(), tank->GetZHalfLength()),
+                         nPoints);
+}
+
+/**
+ * @brief Comparison of the batch transport and FiberOptics::Transport
+ *
+ * @param nPhotons 	Number of random photons in one fiber core
+ *
+ **/
+
+void DetectorConstruction::CheckBatchTransport(G4int nPhotons)
+{
+  if (!fOptics) { return; }
+
+  FiberBatchTransport batch(fOptics, nPhotons);
+  G4double difference = batch.Validate(nPhotons);
+  G4cout
+    << G4endl
+    << " Batch transport check: largest difference of the detection probability of " << nPhotons
+    << " photons " << difference << G4endl;
+  if (difference > 1e-9)
+  {
+    G4Exception("DetectorConstruction::CheckBatchTransport()", "ECal012", JustWarning,
+                "The batch transport does not agree with FiberOptics::Transport");
+  }
+}
 
 /**
  * @brief Construct function to built objects and frame of reference
@@ -43,10 +464,14 @@ DetectorConstruction::~DetectorConstruction()
 
 G4VPhysicalVolume* DetectorConstruction::Construct()
 {
+  G4Timer constructTimer;
+  constructTimer.Start();
+  G4double constructMemory = GeometryBenchmark::ResidentMemory();
+
   G4double a, z, density_pmma, density_ps, pos=18, r = (0.47/2)*mm; /// Useable constants and variables (radius, density and etc.)
   G4int nelements;
 
-  G4double tank_sizeXY = 1.0*mm, tank_sizeZ = 6.3*cm; /// Size of Tank, before: 0.87
+  G4double tank_sizeXY = fPitch, tank_sizeZ = 6.3*cm; /// Size of Tank, before: 0.87
 
   G4NistManager* nist = G4NistManager::Instance(); /// Get nist material manager
 
@@ -127,7 +552,8 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
 
   G4ThreeVector posFiber = posTank;
   G4Tubs* fiberInterior  = new G4Tubs("fInterior", 0*cm, (r-(r*0.02)), tank_sizeZ, 0*deg, 360*deg);
-  G4Tubs* fiberCover 	 = new G4Tubs("fCover", (r-(r*0.02)), r, tank_sizeZ, 0*deg, 360*deg);
+  G4bool nested = (fPlacement != kFiberPlacement); /// the cladding is a full cylinder holding the core
+  G4Tubs* fiberCover 	 = new G4Tubs("fCover", nested ? 0*cm : (r-(r*0.02)), r, tank_sizeZ, 0*deg, 360*deg);
 
 
   G4Material* pmma = new G4Material("PMMA", density_pmma = 1.190*g/cm3, nelements=3);
@@ -149,8 +575,9 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   G4VPhysicalVolume* fiberInterior_phys;
   G4VPhysicalVolume* Tank_phys;
   Tank_phys=new G4PVPlacement(0, posTank, logicTank, "Tank", logicWorld, false, 0, checkOverlaps);
+  G4LogicalVolume* logicCell = 0; /// tungsten around one fiber in replica mode
 	
-	if(fCalSim==true)
+	if(fCalSim==true && fPlacement==kFiberPlacement)
 	{
 	for(int i=0;i<fFiber;i++)
     {
@@ -160,15 +587,42 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
         fiberCover_phys=new G4PVPlacement(0,
                           G4ThreeVector((i*tank_sizeXY)-((fFiber-1)*(tank_sizeXY/2)), (j*tank_sizeXY)-((fFiber-1)*(tank_sizeXY/2)), 0*cm),
                           fiberCoverLog, "fiberCover", logicTank,
-                          false, 0, checkOverlaps);
+                          false, i*fFiber+j, checkOverlaps); /// copy number is the readout channel
         fiberInterior_phys=new G4PVPlacement(0,
                           G4ThreeVector((i*tank_sizeXY)-((fFiber-1)*(tank_sizeXY/2)), (j*tank_sizeXY)-((fFiber-1)*(tank_sizeXY/2)), 0*cm), // fent is lent is pos*cm
                           fiberInteriorLog, "fiberInterior",
-                          logicTank, false, 0, checkOverlaps);
+                          logicTank, false, i*fFiber+j, checkOverlaps);
         
         }
     }
 	}
+	else if(fCalSim==true)
+	{
+	/// one fiber volume, the core placed in the cladding
+	fiberInterior_phys=new G4PVPlacement(0, G4ThreeVector(), fiberInteriorLog, "fiberInterior",
+	                      fiberCoverLog, false, 0, checkOverlaps);
+	
+	if(fPlacement==kFiberReplica)
+	{
+		/// Tank = fFiber columns along x, column = fFiber cells along y, replica numbers i and j
+		G4Box* solidColumn = new G4Box("TankColumn", tank_sizeXY/2, (fFiber)*(tank_sizeXY/2), tank_sizeZ);
+		G4LogicalVolume* logicColumn = new G4LogicalVolume(solidColumn, tank_mat, "TankColumn");
+		G4Box* solidCell = new G4Box("TankCell", tank_sizeXY/2, tank_sizeXY/2, tank_sizeZ);
+		logicCell = new G4LogicalVolume(solidCell, tank_mat, "TankCell");
+		logicColumn->SetVisAttributes(G4VisAttributes::GetInvisible());
+		logicCell->SetVisAttributes(G4VisAttributes::GetInvisible());
+		
+		new G4PVReplica("TankColumn", logicColumn, logicTank, kXAxis, fFiber, tank_sizeXY);
+		new G4PVReplica("TankCell", logicCell, logicColumn, kYAxis, fFiber, tank_sizeXY);
+		fiberCover_phys=new G4PVPlacement(0, G4ThreeVector(), fiberCoverLog, "fiberCover",
+		                  logicCell, false, 0, checkOverlaps);
+	}
+	else
+	{
+		fiberCover_phys=new G4PVParameterised("fiberCover", fiberCoverLog, logicTank, kUndefined,
+		                  fFiber*fFiber, new FiberParameterisation(fFiber, tank_sizeXY));
+	}
+	}
 /**
   * ... Detector ...
   *
@@ -277,6 +731,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   TankSurface->SetFinish(ground);
   TankSurface->SetModel(unified);
   new G4LogicalSkinSurface("TankSurface", logicTank, TankSurface);
+  if (logicCell) { new G4LogicalSkinSurface("TankCellSurface", logicCell, TankSurface); }
 
   G4OpticalSurface*  MirrorSurface = new G4OpticalSurface("MirrorSurface");
   MirrorSurface->SetType(dielectric_metal);
@@ -284,8 +739,111 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   MirrorSurface->SetModel(unified);
   new G4LogicalSkinSurface("MirrorSurface", logicDetec, MirrorSurface);
 
+  ///Fast optics
+
+  delete fOptics;
+  fOptics = new FiberOptics(r-(r*0.02), tank_sizeZ, polyStyrene, pmma, detec_mat);
+  fTankCenter = posTank;
+
+  ///Regions of the production cuts, "Fibers" is the envelope of FiberOpticsModel as well
+
+  G4Region* absorberRegion = new G4Region("Absorber"); /// tungsten, cells of the replica included
+  absorberRegion->AddRootLogicalVolume(logicTank);
+  G4Region* fiberRegion = new G4Region("Fibers");
+  fiberRegion->AddRootLogicalVolume(fiberCoverLog);
+  if (!nested) { fiberRegion->AddRootLogicalVolume(fiberInteriorLog); }
+  G4Region* detectorRegion = new G4Region("Photodetector");
+  detectorRegion->AddRootLogicalVolume(logicDetec);
+
+  delete fLightTable;
+  fLightTable = 0;
+  if (fTransport == kFiberTransportTable)
+  {
+    /// depth 4.2 mm, 5 rings of equal area, 40 direction cosines, delays up to 5 ns
+    fLightTable = new FiberLightTable(30, 5, 40, 100, tank_sizeZ, r-(r*0.02), 5*ns);
+    std::vector<const G4Material*> opticalMaterials;
+    opticalMaterials.push_back(polyStyrene);
+    opticalMaterials.push_back(pmma);
+    opticalMaterials.push_back(detec_mat);
+    fLightTable->SetMaterials(opticalMaterials);
+    fLightTable->SetOrigin(posTank - G4ThreeVector((fFiber-1)*(tank_sizeXY/2), (fFiber-1)*(tank_sizeXY/2), 0)); /// fiber of channel 0
+
+    char fileName[64];
+    std::snprintf(fileName, sizeof(fileName), "fiberlight_%016llx.lut", (unsigned long long)fLightTable->GetKey());
+    fLightTableFile = fileName;
+    G4cout << G4endl << " Fiber light table " << fLightTableFile
+           << (fLightTable->Load(fLightTableFile) ? ": loaded" : ": not found, filled with full tracking before the run")
+           << G4endl;
+  }
+
+  fLimits->Apply(); /// step limits of the regions and volumes set so far
+
+  fWorld = physWorld;
+  fTank = Tank_phys;
+
+  constructTimer.Stop();
+  static const char* names[] = { "placement", "replica", "parameterised" };
+  static const char* transports[] = { "full", "fast", "table", "batch" };
+  G4cout << G4endl << " Geometry (" << names[fPlacement] << "): " << fFiber*fFiber << " fibers, "
+         << G4PhysicalVolumeStore::GetInstance()->size() << " physical volumes, constructed in "
+         << constructTimer.GetRealElapsed() << " s, resident memory +"
+         << GeometryBenchmark::ResidentMemory() - constructMemory << " MB, optical transport in fibers: "
+         << transports[fTransport] << G4endl;
+
   return physWorld;
 
 }
 
+/**
+ * @brief Readout of the fiber cores and the Detector, built on every thread
+ *
+ * Collections: "fiberSD/fiberHits" (energy deposit per fiber) and
+ * "detectorSD/detectorHits" (optical photons and energy deposit in the Detector).
+ * Channel i*fFiber+j is the fiber of copy number i*fFiber+j and the Detector area behind it.
+ * The deposit of the tungsten volumes and the claddings is summed by a G4PSEnergyDeposit
+ * scorer ("calorimeterSD/edep"), which runs no user code. Only if the shower is scored
+ * (/ECal/scoring/shower) do they get AbsorberSD as well, for the profiles and step records.
+ * The fast optical model is attached to the "Fibers" region here as well.
+ *
+ **/
+
+void DetectorConstruction::ConstructSDandField()
+{
+  G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+
+  FiberSD* fiberSD = new FiberSD("fiberSD", "fiberHits", fFiber, fPlacement);
+  sdManager->AddNewDetector(fiberSD);
+  SetSensitiveDetector("fiberInterior", fiberSD);
+
+  DetectorSD* detectorSD = new DetectorSD("detectorSD", "detectorHits", fFiber);
+  sdManager->AddNewDetector(detectorSD);
+  SetSensitiveDetector("Detector", detectorSD);
+
+  G4MultiFunctionalDetector* calorimeterSD = new G4MultiFunctionalDetector("calorimeterSD");
+  calorimeterSD->RegisterPrimitive(new G4PSEnergyDeposit("edep"));
+  sdManager->AddNewDetector(calorimeterSD);
+  AbsorberSD* absorberSD = 0;
+  if (fScoreShower)
+  {
+    absorberSD = new AbsorberSD("absorberSD");
+    sdManager->AddNewDetector(absorberSD);
+  }
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  for (std::size_t i = 0; i < store->size(); i++)
+  {
+    const G4String& name = (*store)[i]->GetName();
+    if (name == "Tank" || name == "TankColumn" || name == "TankCell" || name == "fiberCover")
+    {
+      SetSensitiveDetector((*store)[i], calorimeterSD); /// the cells exist only in the replica layout
+      if (absorberSD) { SetSensitiveDetector((*store)[i], absorberSD); } /// both in a G4MultiSensitiveDetector
+    }
+  }
+
+  if (fTransport == kFiberTransportFast || fTransport == kFiberTransportTable)
+  {
+    new FiberOpticsModel("FiberOpticsModel", G4RegionStore::GetInstance()->GetRegion("Fibers"), fOptics,
+                         fLightTable, detectorSD);
+  }
+}
+
 /// End of file
@@ -0,0 +1,157 @@
+/**
+ * @file /ECal_MT/src/DetectorSD.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's sensitive detector source code of the photodetector plate.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "DetectorSD.hh"
+#include "DetectorConstruction.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4SDManager.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4RunManager.hh"
+#include "StackingAction.hh"
+#include "EventAction.hh"
+#include "G4EventManager.hh"
+#include "Run.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Constructor of Detector SD
+ *
+ * @param name 					Name of the sensitive detector
+ * @param hitsCollectionName 	Name of the collection of detected photons and energy deposits
+ * @param nFiber 				Number of fibers in one line, the Detector has a channel behind every fiber;
+ * 								the channel of a point is given by DetectorConstruction::GetChannel
+ *
+ **/
+
+DetectorSD::DetectorSD(const G4String& name, const G4String& hitsCollectionName, G4int nFiber)
+: G4VSensitiveDetector(name), fHitsCollection(0), fHitIndex(nFiber * nFiber, -1),
+  fOpticalPhoton(G4OpticalPhoton::Definition()), fDetector(0), fEventAction(0), fEfficiency(false), fWeight(1)
+{
+  collectionName.insert(hitsCollectionName);
+  fDetector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+}
+
+/// @brief Destructor of Detector SD
+
+DetectorSD::~DetectorSD()
+{}
+
+/// @brief New hits collection of the event
+
+void DetectorSD::Initialize(G4HCofThisEvent* hce)
+{
+  fHitsCollection = new FiberHitsCollection(SensitiveDetectorName, collectionName[0]);
+  G4int hcID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
+  hce->AddHitsCollection(hcID, fHitsCollection);
+  std::fill(fHitIndex.begin(), fHitIndex.end(), -1);
+  fEfficiency = fDetector->GetEfficiencyMode() == kEfficiencyAtDetector;
+  fWeight = fDetector->GetPhotonWeight();
+  fEventAction = static_cast<EventAction*>(G4EventManager::GetEventManager()->GetUserEventAction());
+}
+
+/// @brief Hit of a channel, created at its first use in the event
+
+FiberHit* DetectorSD::GetHit(G4int channel)
+{
+  if (fHitIndex[channel] < 0) { fHitIndex[channel] = fHitsCollection->insert(new FiberHit(channel)) - 1; }
+  return (*fHitsCollection)[fHitIndex[channel]];
+}
+
+/// @brief Sampling the photon detection efficiency of a photon at the Detector, true without it
+
+G4bool DetectorSD::IsDetected(G4double energy) const
+{
+  if (!fEfficiency) { return true; }
+  G4bool detected = G4UniformRand() < fDetector->GetDetectionEfficiency(energy);
+  static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun())->CountEfficiency(detected);
+  return detected;
+}
+
+/// @brief Photon arriving within the readout window, the late ones are counted in the run
+
+G4bool DetectorSD::IsInWindow(G4double time) const
+{
+  if (!fDetector->IsLate(time, true, 0.)) { return true; }
+  static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun())->CountLate(true, 0.);
+  return false;
+}
+
+/**
+ * @brief Counting a photon which is not tracked to the Detector (light table of FiberOpticsModel)
+ *
+ * @param position 	Any point of the fiber of the photon
+ * @param time 		Arrival time at the Detector
+ * @param energy 	Energy of the photon
+ *
+ **/
+
+void DetectorSD::AddPhoton(const G4ThreeVector& position, G4double time, G4double energy)
+{
+  if (IsInWindow(time) && IsDetected(energy)) { GetHit(fDetector->GetChannel(position))->AddPhoton(time, fWeight); }
+}
+
+/**
+ * @brief Counting an optical photon at its first step in the Detector
+ *
+ * The photon is absorbed (killed) where it is counted, as in a photocathode, so it is
+ * counted once even if it would be reflected back into a fiber. This is a model choice:
+ * the glass of the Detector is not followed, reflections at its back face and photons
+ * returning to the fibers are not simulated. Every photon stands for
+ * the photon weight of generated photons. With the efficiency
+ * sampled at the Detector an undetected photon is absorbed without a count, and so is a
+ * photon arriving after the readout window.
+ *
+ **/
+
+G4bool DetectorSD::ReadOut(G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+
+  /// channel of the fiber in front of the entry point
+  G4int channel = fDetector->GetChannel(step->GetPreStepPoint()->GetPosition());
+
+  if (track->GetDefinition() == fOpticalPhoton)
+  {
+    if (!IsInWindow(step->GetPreStepPoint()->GetGlobalTime()) || !IsDetected(track->GetKineticEnergy()))
+    {
+      track->SetTrackStatus(fStopAndKill);
+      return false;
+    }
+    GetHit(channel)->AddPhoton(step->GetPreStepPoint()->GetGlobalTime(), fWeight);
+    if (track->GetUserInformation() && dynamic_cast<OutsideCutInformation*>(track->GetUserInformation()))
+    {
+      /// validation of the trapping cut: this photon would have been killed
+      static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun())->AddRejectedDetected(fWeight);
+    }
+    track->SetTrackStatus(fStopAndKill);
+    return true;
+  }
+
+  G4double edep = step->GetTotalEnergyDeposit();
+  if (edep == 0.) { return false; }
+  GetHit(channel)->AddEdep(edep);
+  return true;
+}
+
+/// @brief Reading out a step, then scoring it like any step of the calorimeter
+
+G4bool DetectorSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  G4bool hit = ReadOut(step);
+  fEventAction->ScoreStep(step); /// profiles and step records, nothing is killed there
+  return hit;
+}
+
+/// End of file
@@ -11,22 +11,59 @@
  **/
 
 #include "EventAction.hh"
+#include "StackingAction.hh"
+#include "G4Threading.hh"
+#include "G4SDManager.hh"
+#include "G4HCofThisEvent.hh"
+#include "FiberHit.hh"
+#include "DetectorConstruction.hh"
+#include "GenstepOutput.hh"
+#include "StepDictionary.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VProcess.hh"
+#include "G4THitsMap.hh"
+
+#include <algorithm>
 
 /**
  * @brief Constructor of Event action
  * 
- * @param detectorHit 	Counter for photons in Detector
+ * @param fFiberHCID, fDetectorHCID, fCalorimeterHCID 	Hit collection IDs, looked up at the first event
+ * @param fRun 		Current run of the thread, cached for the stepping action
+ * @param fLogSteps 	Step records are written in this run
+ * @param fStepBuffer 	Binary step records of the thread, handed to the writer of steps.bin
+ * @param fChannelEdep, fChannelPhotons 	Per-channel row of the event (fiber^2 channels)
+ * @param fLogGensteps 	Optical photon generating steps are written in this run (gensteps.bin)
+ * @param fStackingAction 	Stacking action of the thread, its photon batch is flushed before the hits are read
+ * @param fTableRun 	The run fills the fiber light table, its photons are not scored
+ * @param fScoreShower 	Steps fill the profiles and step records, fixed at initialization
  * 
  **/
 
 EventAction::EventAction()
-: G4UserEventAction(), detectorHit(0)
-{}
+: G4UserEventAction(), fFiberHCID(-1), fDetectorHCID(-1), fCalorimeterHCID(-1), fEventID(0), fRun(0), fLogSteps(false), fStepBuffer(0),
+  fLogGensteps(false), fStackingAction(0), fDetector(0), fDictionary(StepDictionary::Instance()),
+  fTableRun(false), fScoreShower(true)
+{
+  fStepBuffer = new StepRecordBuffer(G4Threading::G4GetThreadId());
+
+  fDetector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  fChannelEdep.resize(fDetector->GetFiber() * fDetector->GetFiber());
+  fChannelPhotons.resize(fChannelEdep.size());
+  fScoreShower = fDetector->IsScoringShower();
+}
 
 /// @brief Destructor of Event action
 
 EventAction::~EventAction()
-{}
+{
+  delete fStepBuffer;
+}
 
 /**
  * @brief Beginning of event
@@ -35,8 +72,14 @@ EventAction::~EventAction()
  * 
  **/
 
-void EventAction::BeginOfEventAction(const G4Event*)
+void EventAction::BeginOfEventAction(const G4Event* event)
 {
+  fEventID = event->GetEventID();
+  fRun = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+  fLogSteps = StepRecordBuffer::IsEnabled();
+  fLogGensteps = GenstepOutput::Instance() && GenstepOutput::Instance()->IsRunning();
+  fTableRun = fRun->GetLightTable() != 0;
+  fGensteps.clear();
 }
 
 /**
@@ -46,8 +89,119 @@ void EventAction::BeginOfEventAction(const G4Event*)
  * 
  **/
 
-void EventAction::EndOfEventAction(const G4Event*)
+void EventAction::EndOfEventAction(const G4Event* event)
+{
+  if (fStackingAction) { fStackingAction->FlushBatch(); } /// photons of the batch transport left in the batch
+
+  if (fFiberHCID < 0)
+  {
+    fFiberHCID = G4SDManager::GetSDMpointer()->GetCollectionID("fiberSD/fiberHits");
+    fDetectorHCID = G4SDManager::GetSDMpointer()->GetCollectionID("detectorSD/detectorHits");
+    fCalorimeterHCID = G4SDManager::GetSDMpointer()->GetCollectionID("calorimeterSD/edep");
+  }
+
+  G4HCofThisEvent* hce = event->GetHCofThisEvent();
+  if (hce)
+  {
+    /// hits are scattered to the dense row, only channels with a hit are touched
+    std::fill(fChannelEdep.begin(), fChannelEdep.end(), 0.f);
+    std::fill(fChannelPhotons.begin(), fChannelPhotons.end(), 0);
+
+    const FiberHitsCollection* fiberHits = static_cast<const FiberHitsCollection*>(hce->GetHC(fFiberHCID));
+    G4double fiberEdep = 0.;
+    for (std::size_t i = 0; i < fiberHits->entries(); i++)
+    {
+      const FiberHit* hit = (*fiberHits)[i];
+      fChannelEdep[hit->GetChannel()] = hit->GetEdep() / MeV;
+      fiberEdep += hit->GetEdep();
+    }
+    fRun->AddFiberEdep(fiberEdep);
+
+    /// the rest of the calorimeter, one entry per copy number of the tungsten volumes and claddings
+    G4double calorimeterEdep = fiberEdep;
+    const G4THitsMap<G4double>* absorberEdep = static_cast<const G4THitsMap<G4double>*>(hce->GetHC(fCalorimeterHCID));
+    std::map<G4int, G4double*>::const_iterator it;
+    for (it = absorberEdep->GetMap()->begin(); it != absorberEdep->GetMap()->end(); ++it) { calorimeterEdep += *it->second; }
+    fRun->AddCalorimeterEdep(calorimeterEdep);
+
+    const FiberHitsCollection* detectorHits = static_cast<const FiberHitsCollection*>(hce->GetHC(fDetectorHCID));
+    G4int photons = 0;
+    for (std::size_t i = 0; i < detectorHits->entries(); i++)
+    {
+      const FiberHit* hit = (*detectorHits)[i];
+      fChannelPhotons[hit->GetChannel()] = hit->GetPhotons();
+      photons += hit->GetPhotons();
+    }
+    fRun->AddDetectedPhotons(fEventID, photons);
+
+    ChannelOutput* channels = ChannelOutput::Instance();
+    if (channels && channels->IsRunning())
+    {
+      channels->WriteRow(fEventID, fChannelEdep.data(), fChannelPhotons.data());
+    }
+  }
+
+  if (fLogGensteps) { GenstepOutput::Instance()->WriteEvent(fEventID, fGensteps); }
+
+  fStepBuffer->Flush();
+}
+
+/**
+ * @brief Scoring of a step in the calorimeter or in the Detector
+ *
+ * Called by AbsorberSD, FiberSD and DetectorSD, so Geant4 calls no user code for the steps
+ * of the World; nothing is done unless the shower is scored. Steps of secondaries with an
+ * energy deposit or ending in the Detector fill the profiles and the step log; the last
+ * steps of stopping tracks are included. Tracks past the readout window and secondaries
+ * leaving into the World are killed by TrackKiller, not here.
+ *
+ * @param step 	Step starting in an instrumented volume
+ *
+ **/
+
+void EventAction::ScoreStep(const G4Step* step)
 {
+  if (fTableRun || !fScoreShower) { return; } /// photons of the light table are counted by SteppingAction
+
+  const G4Track* track = step->GetTrack();
+  const G4StepPoint* post = step->GetPostStepPoint();
+
+  const G4VProcess* creator = track->GetCreatorProcess();
+  if (creator == 0) { return; } /// primaries are not recorded
+
+  const G4VPhysicalVolume* postVolume = post->GetPhysicalVolume();
+  if (postVolume == 0) { return; }
+
+  const G4LogicalVolume* postLog = postVolume->GetLogicalVolume();
+
+  G4double edep = step->GetTotalEnergyDeposit();
+  if (edep == 0 && postLog != fDictionary->GetDetector()) { return; }
+
+  const G4ThreeVector& postPos = post->GetPosition();
+  fRun->GetProfile()->Fill(postPos, edep); /// online TH1D0 and TH2D1
+
+  if (!fLogSteps) { return; }
+
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  const G4ThreeVector& prePos = pre->GetPosition();
+
+  StepRecord record;
+  record.eventID = fEventID;
+  record.trackID = track->GetTrackID();
+  record.particle = fDictionary->ParticleID(track->GetDefinition());
+  record.process = fDictionary->ProcessID(creator);
+  record.preVolume = fDictionary->VolumeID(pre->GetPhysicalVolume()->GetLogicalVolume());
+  record.postVolume = fDictionary->VolumeID(postLog);
+  record.edep = edep / MeV;
+  record.preX = prePos.x() / cm;
+  record.preY = prePos.y() / cm;
+  record.preZ = prePos.z() / cm;
+  record.postX = postPos.x() / cm;
+  record.postY = postPos.y() / cm;
+  record.postZ = postPos.z() / cm;
+  record.postTime = post->GetLocalTime() / ns;
+
+  fStepBuffer->Append(record); /// no formatting and no shared lock on the hot path
 }
 
 /// End of file
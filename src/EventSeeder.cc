@@ -0,0 +1,110 @@
+/**
+ * @file /ECal_MT/src/EventSeeder.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's random seeds of the events derived from the master seed.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "EventSeeder.hh"
+#include "Randomize.hh"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace
+{
+  /// SplitMix64 step, neighbouring inputs give independent outputs
+  std::uint64_t Mix(std::uint64_t x)
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+}
+
+EventSeeder* EventSeeder::fInstance = 0;
+
+/**
+ * @brief Constructor of Event seeder
+ *
+ * @param seed 	Master seed of the job
+ *
+ **/
+
+EventSeeder::EventSeeder(G4long seed)
+: fSeed(seed), fFirstEvent(0), fMessenger(0)
+{
+  fInstance = this;
+
+  fMessenger = new G4GenericMessenger(this, "/ECal/random/", "Random seeds of the events");
+  fMessenger->DeclareMethod("seed", &EventSeeder::SetSeedCommand)
+    .SetGuidance("Master seed, the seed of every event is derived from it and from the index of the event")
+    .SetParameterName("seed", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fMessenger->DeclareMethod("firstEvent", &EventSeeder::SetFirstEventCommand)
+    .SetGuidance("Index of the first event of the next run (events of the previous runs by default),")
+    .SetGuidance("e.g. /ECal/random/firstEvent 1234 and /run/beamOn 1 replay the event of index 1234")
+    .SetParameterName("index", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+/// @brief Destructor of Event seeder
+
+EventSeeder::~EventSeeder()
+{
+  delete fMessenger;
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/// @brief Setting the master seed (any 64 bit integer)
+
+void EventSeeder::SetSeedCommand(const G4String& seed)
+{
+  fSeed = std::strtoll(seed.c_str(), 0, 10);
+}
+
+/// @brief Setting the index of the first event of the next run (any non-negative 64 bit integer)
+
+void EventSeeder::SetFirstEventCommand(const G4String& index)
+{
+  G4long first = std::strtoll(index.c_str(), 0, 10);
+  if (first < 0)
+  {
+    G4Exception("EventSeeder::SetFirstEventCommand()", "ECal013", JustWarning,
+                ("Negative first event index " + index + ", the index is kept").c_str());
+    return;
+  }
+  fFirstEvent = first;
+}
+
+/**
+ * @brief Reseeding the engine of the thread with seeds of the event
+ *
+ * @param eventID 	ID of the event in the current run
+ *
+ **/
+
+void EventSeeder::SeedEvent(G4int eventID) const
+{
+  std::uint64_t hash = Mix(Mix((std::uint64_t)fSeed) ^ (std::uint64_t)(fFirstEvent + eventID));
+  long seeds[3];
+  seeds[0] = (long)(hash & 0x7ffffffeULL) + 1;           /// positive 31 bit seeds of RanecuEngine
+  seeds[1] = (long)((hash >> 32) & 0x7ffffffeULL) + 1;
+  seeds[2] = 0;
+  G4Random::setTheSeeds(seeds);
+}
+
+/// @brief Printing the seed and the first index of the run (master)
+
+void EventSeeder::BeginOfRun() const
+{
+  G4cout << G4endl << " Event seeds: master seed " << fSeed << ", first event index " << fFirstEvent << G4endl;
+}
+
+/// End of file
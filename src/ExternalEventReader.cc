@@ -0,0 +1,287 @@
+/**
+ * @file /ECal_MT/src/ExternalEventReader.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's streaming reader of external generator events.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "ExternalEventReader.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ExternalEventReader* ExternalEventReader::fInstance = 0;
+
+namespace
+{
+  const std::size_t kWillNeed = 4 << 20; /// bytes handed to the kernel for read ahead at once
+
+  G4bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+  /// @brief Number of a text event, the mapping is not null terminated so the token is copied
+  G4bool ReadNumber(const char*& p, const char* end, G4double& value)
+  {
+    while (p < end && IsSpace(*p)) { p++; }
+    char token[64];
+    std::size_t length = 0;
+    while (p < end && !IsSpace(*p) && length < sizeof(token) - 1) { token[length++] = *p++; }
+    token[length] = 0;
+    char* last = 0;
+    value = std::strtod(token, &last);
+    return length > 0 && last == token + length;
+  }
+}
+
+/// @brief Constructor of External event reader
+
+ExternalEventReader::ExternalEventReader()
+: fData(0), fSize(0), fBegin(0), fBinary(false), fFirst(0),
+  fIndexed(0), fRequested(0), fIndexDone(false), fStop(false), fEventsRead(0), fStalls(0), fPastEnd(false)
+{
+  fInstance = this;
+}
+
+/// @brief Destructor of External event reader
+
+ExternalEventReader::~ExternalEventReader()
+{
+  Close();
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/**
+ * @brief Mapping an event file and starting its index thread
+ *
+ * @param fileName 	ECALEVT1 binary file or HEPEVT text file
+ *
+ * @return	False if the file is missing, empty or a binary file of another record size
+ *
+ **/
+
+G4bool ExternalEventReader::Open(const G4String& fileName)
+{
+  Close();
+
+  fFileName = fileName;
+  int fd = open(fFileName.c_str(), O_RDONLY);
+  if (fd < 0) { return false; }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) { close(fd); return false; }
+  void* data = mmap(0, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) { return false; }
+  madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+  fData = static_cast<const char*>(data);
+  fSize = info.st_size;
+
+  ExternalFileHeader header;
+  fBinary = fSize >= sizeof(header) && std::memcmp(fData, "ECALEVT1", sizeof(header.magic)) == 0;
+  fBegin = 0;
+  if (fBinary)
+  {
+    std::memcpy(&header, fData, sizeof(header));
+    if (header.recordSize != sizeof(ExternalParticle)) { Close(); return false; }
+    fBegin = sizeof(header);
+  }
+
+  /// smallest events: a count of 0 particles, 4 bytes binary or "0\n" as text
+  std::size_t maxEvents = (fSize - fBegin) / (fBinary ? sizeof(std::uint32_t) : 2) + 1;
+  fChunks.assign(maxEvents / kChunk + 1, 0);
+
+  fIndexed = 0;
+  fRequested = fFirst;
+  fIndexDone = false;
+  fStop = false;
+  fPastEnd = false;
+  fEventsRead = 0;
+  fStalls = 0;
+  fIndexer = std::thread(&ExternalEventReader::IndexLoop, this);
+  return true;
+}
+
+/// @brief Stopping the index thread and unmapping the file
+
+void ExternalEventReader::Close()
+{
+  fStop = true;
+  if (fIndexer.joinable()) { fIndexer.join(); }
+  if (fData) { munmap(const_cast<char*>(fData), fSize); }
+  fData = 0;
+  fSize = 0;
+  for (std::size_t i = 0; i < fChunks.size(); i++) { delete [] fChunks[i]; }
+  fChunks.clear();
+  fIndexed = 0;
+}
+
+/**
+ * @brief End of an event
+ *
+ * @param event 	First byte of the event (count of particles)
+ *
+ * @return	First byte after the event, 0 if the event is truncated or is not an event
+ *
+ **/
+
+const char* ExternalEventReader::NextEvent(const char* event) const
+{
+  const char* end = fData + fSize;
+  if (fBinary)
+  {
+    std::uint32_t count;
+    if ((std::size_t)(end - event) < sizeof(count)) { return 0; }
+    std::memcpy(&count, event, sizeof(count));
+    std::size_t length = sizeof(count) + (std::size_t)count * sizeof(ExternalParticle);
+    return ((std::size_t)(end - event) < length) ? 0 : event + length;
+  }
+
+  const char* p = event;
+  G4double count;
+  if (!ReadNumber(p, end, count) || count < 0 || count > fSize) { return 0; }
+  for (G4long line = 0; line <= (G4long)count; line++)  /// the rest of the NHEP line, then the particles
+  {
+    if (p == end) { return 0; }
+    p = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    p = p ? p + 1 : end;
+  }
+  return p;
+}
+
+/**
+ * @brief Body of the index thread
+ *
+ * The thread stays at most kReadAhead events ahead of the workers and asks the kernel to
+ * read the pages of the indexed events, so the workers find them resident.
+ *
+ **/
+
+void ExternalEventReader::IndexLoop()
+{
+  const char* end = fData + fSize;
+  const char* event = fData + fBegin;
+  std::size_t count = 0, willNeed = 0;
+
+  while (!fStop.load(std::memory_order_relaxed))
+  {
+    if (count >= fRequested.load(std::memory_order_relaxed) + kReadAhead)
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      continue;
+    }
+    if (!fBinary) { while (event < end && IsSpace(*event)) { event++; } }
+    const char* next = (event < end) ? NextEvent(event) : 0;
+    if (!next) { break; }
+
+    std::uint64_t*& chunk = fChunks[count / kChunk];
+    if (!chunk) { chunk = new std::uint64_t[kChunk]; }
+    chunk[count % kChunk] = event - fData;
+    fIndexed.store(++count, std::memory_order_release);  /// the offset is visible with the count
+    event = next;
+
+    while (willNeed < (std::size_t)(event - fData) && willNeed < fSize)
+    {
+      madvise(const_cast<char*>(fData) + willNeed, std::min(kWillNeed, fSize - willNeed), MADV_WILLNEED);
+      willNeed += kWillNeed;  /// the mapping is page aligned, so are the windows
+    }
+  }
+  fIndexDone.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Final state particles of a text event, ISTHEP 1
+ *
+ * @param event 		First byte of the event (NHEP)
+ * @param particles 	Particles of the event, appended
+ *
+ **/
+
+G4bool ExternalEventReader::ParseText(const char* event, std::vector<ExternalParticle>& particles) const
+{
+  const char* end = fData + fSize;
+  const char* p = event;
+  G4double count, value[8];
+  if (!ReadNumber(p, end, count)) { return false; }
+  for (G4long i = 0; i < (G4long)count; i++)
+  {
+    for (G4int k = 0; k < 8; k++) { if (!ReadNumber(p, end, value[k])) { return false; } }
+    if ((G4int)value[0] != 1) { continue; }  /// documentation and decayed entries
+    ExternalParticle particle;
+    particle.pdg = (std::int32_t)value[1];
+    particle.px = value[4];
+    particle.py = value[5];
+    particle.pz = value[6];
+    particles.push_back(particle);
+  }
+  return true;
+}
+
+/**
+ * @brief Reading the particles of an event
+ *
+ * @param index 		Index of the event in the file
+ * @param particles 	Final state particles of the event, replaced
+ *
+ * @return	False if the file has no such event
+ *
+ **/
+
+G4bool ExternalEventReader::ReadEvent(std::size_t index, std::vector<ExternalParticle>& particles)
+{
+  particles.clear();
+  if (!fData) { return false; }
+
+  std::size_t requested = fRequested.load(std::memory_order_relaxed);
+  while (requested < index + 1 && !fRequested.compare_exchange_weak(requested, index + 1)) {}
+
+  if (fIndexed.load(std::memory_order_acquire) <= index)
+  {
+    if (!fIndexDone.load(std::memory_order_acquire)) { fStalls++; }
+    while (fIndexed.load(std::memory_order_acquire) <= index && !fIndexDone.load(std::memory_order_acquire))
+    {
+      std::this_thread::yield();
+    }
+    if (fIndexed.load(std::memory_order_acquire) <= index)
+    {
+      if (!fPastEnd.exchange(true))
+      {
+        G4Exception("ExternalEventReader::ReadEvent()", "ECal011", JustWarning,
+                    ("The events of " + fFileName + " are used up, later events have no primaries").c_str());
+      }
+      return false;
+    }
+  }
+
+  const char* event = fData + fChunks[index / kChunk][index % kChunk];
+  fEventsRead++;
+  if (!fBinary) { return ParseText(event, particles); }
+
+  std::uint32_t count;
+  std::memcpy(&count, event, sizeof(count));
+  particles.resize(count);
+  if (count > 0) { std::memcpy(particles.data(), event + sizeof(count), count * sizeof(ExternalParticle)); }
+  return true;
+}
+
+/// @brief Events read and reads of the workers that waited since the file was opened
+
+void ExternalEventReader::Report() const
+{
+  G4cout
+    << G4endl
+    << " External events (" << fFileName << (fBinary ? ", binary" : ", HEPEVT") << "): "
+    << fEventsRead.load() << " read, " << fIndexed.load() << " indexed"
+    << (fIndexDone.load() ? " (end of file), " : ", ")
+    << fStalls.load() << " reads waited for the index thread" << G4endl;
+}
+
+/// End of file
@@ -0,0 +1,218 @@
+/**
+ * @file /ECal_MT/src/FiberBatchTransport.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's batched transport of the optical photons of an event in the fiber grid.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "FiberBatchTransport.hh"
+#include "FiberOptics.hh"
+#include "DetectorSD.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  /// FiberOptics::Reflectivity without branches, so the loop calling it is vectorised
+  inline G4double Fresnel(G4double cosIncidence, G4double n1, G4double n2)
+  {
+    G4double ratio = n1 / n2;
+    G4double sinT2 = ratio * ratio * std::max(0., 1 - cosIncidence * cosIncidence);
+    G4double cosT = std::sqrt(std::max(0., 1 - sinT2));
+    G4double rs = (n1*cosIncidence - n2*cosT) / std::max(n1*cosIncidence + n2*cosT, 1e-300);
+    G4double rp = (n2*cosIncidence - n1*cosT) / std::max(n2*cosIncidence + n1*cosT, 1e-300);
+    return sinT2 >= 1 ? 1. : 0.5 * (rs*rs + rp*rp);
+  }
+}
+
+/**
+ * @brief Constructor of Fiber batch transport, built on every thread
+ *
+ * @param optics 		Light transport of the core, shared by the threads
+ * @param batchSize 	Photons processed together, the arrays are reserved for it
+ *
+ **/
+
+FiberBatchTransport::FiberBatchTransport(const FiberOptics* optics, std::size_t batchSize)
+: fOptics(optics), fDetectorSD(0), fBatchSize(batchSize), fPhotons(0), fDetected(0), fBatches(0)
+{
+  std::vector<G4double>* arrays[] = { &fGlobalX, &fGlobalY, &fX, &fY, &fZ, &fUX, &fUY, &fUZ, &fEnergy, &fTime,
+                                      &fCoreIndex, &fCladdingIndex, &fWindowIndex, &fAbsorption, &fRandom,
+                                      &fProbability, &fArrival };
+  for (std::size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) { arrays[i]->reserve(fBatchSize); }
+}
+
+/// @brief Dropping the collected photons without transport
+
+void FiberBatchTransport::Clear()
+{
+  fGlobalX.clear();
+  fGlobalY.clear();
+  fX.clear();
+  fY.clear();
+  fZ.clear();
+  fUX.clear();
+  fUY.clear();
+  fUZ.clear();
+  fEnergy.clear();
+  fTime.clear();
+}
+
+/**
+ * @brief Probability of reaching the Detector and arrival time of the collected photons
+ *
+ * @param n 	Number of collected photons
+ *
+ **/
+
+void FiberBatchTransport::Evaluate(G4int n)
+{
+  /// material properties at the photon energies
+  fCoreIndex.resize(n);
+  fCladdingIndex.resize(n);
+  fWindowIndex.resize(n);
+  fAbsorption.resize(n);
+  fProbability.resize(n);
+  fArrival.resize(n);
+  for (G4int i = 0; i < n; i++)
+  {
+    fCoreIndex[i] = fOptics->GetRefractiveIndex(fEnergy[i]);
+    fCladdingIndex[i] = fOptics->GetCladdingIndex(fEnergy[i]);
+    fWindowIndex[i] = fOptics->GetWindowIndex(fEnergy[i]);
+    fAbsorption[i] = fOptics->GetAbsorptionLength(fEnergy[i]);
+  }
+
+  /// unfolded path to the end face: every wall reflection has the same angle of incidence
+  const G4double a = fOptics->GetCoreRadius();
+  const G4double h = fOptics->GetHalfLength();
+  const G4double* x = fX.data();
+  const G4double* y = fY.data();
+  const G4double* z = fZ.data();
+  const G4double* ux = fUX.data();
+  const G4double* uy = fUY.data();
+  const G4double* uz = fUZ.data();
+  const G4double* time = fTime.data();
+  const G4double* n1 = fCoreIndex.data();
+  const G4double* n2 = fCladdingIndex.data();
+  const G4double* nw = fWindowIndex.data();
+  const G4double* absorption = fAbsorption.data();
+  G4double* probability = fProbability.data();
+  G4double* arrival = fArrival.data();
+
+  for (G4int i = 0; i < n; i++)
+  {
+    G4double length = (h - z[i]) / std::max(uz[i], 1e-12);
+    G4double sinTheta = std::sqrt(std::max(0., 1 - uz[i]*uz[i]));
+    G4double inverse = sinTheta > 0 ? 1 / sinTheta : 0.;
+    G4double dx = ux[i] * inverse, dy = uy[i] * inverse;
+    G4double transverse = length * sinTheta;
+
+    G4double b = x[i]*dx + y[i]*dy;
+    G4double c = x[i]*x[i] + y[i]*y[i] - a*a;
+    G4double wall = -b + std::sqrt(std::max(0., b*b - c));
+    G4double cosNormal = std::min(1., std::max(0., (dx*(x[i] + wall*dx) + dy*(y[i] + wall*dy)) / a));
+    G4double chord = 2 * a * cosNormal;
+    /// a grazing photon (chord 0) stays at its first reflection, the division stays finite
+    G4double safeChord = chord > 0 ? chord : 1.;
+    G4double between = chord > 0 ? std::floor((transverse - wall) / safeChord) : 0.;
+    G4double reflections = transverse > wall ? 1 + between : 0.;
+
+    G4double p = std::exp(-length / absorption[i])
+               * std::pow(Fresnel(sinTheta*cosNormal, n1[i], n2[i]), reflections)
+               * (1 - Fresnel(uz[i], n1[i], nw[i]));
+    probability[i] = uz[i] > 0 ? p : 0.;
+    arrival[i] = time[i] + length * n1[i] / c_light;
+  }
+}
+
+/**
+ * @brief Transporting the collected photons and counting the detected ones in DetectorSD
+ *
+ * @return	Number of photons reaching the Detector
+ *
+ **/
+
+G4int FiberBatchTransport::Flush()
+{
+  const G4int n = fX.size();
+  if (n == 0) { return 0; }
+
+  fRandom.resize(n);
+  G4Random::getTheEngine()->flatArray(n, fRandom.data());
+  Evaluate(n);
+
+  G4int detected = 0;
+  for (G4int i = 0; i < n; i++)
+  {
+    if (fRandom[i] >= fProbability[i]) { continue; }
+    fDetectorSD->AddPhoton(G4ThreeVector(fGlobalX[i], fGlobalY[i], 0.), fArrival[i], fEnergy[i]);
+    detected++;
+  }
+
+  fPhotons += n;
+  fDetected += detected;
+  fBatches++;
+  Clear();
+  return detected;
+}
+
+/**
+ * @brief Comparing the batch model with FiberOptics::Transport on random photons of a core
+ *
+ * FiberOptics::Transport stops at the end face, the boundary process of the tracking does
+ * the Fresnel transmission into the Detector, so its probability is multiplied by the
+ * transmission here. The collected photons are dropped.
+ *
+ * @param photons 	Number of photons, uniform in the core, isotropic forwards, 2-3.5 eV
+ *
+ * @return	Largest difference of the two probabilities
+ *
+ **/
+
+G4double FiberBatchTransport::Validate(G4int photons)
+{
+  Clear();
+  const G4double a = fOptics->GetCoreRadius();
+  const G4double h = fOptics->GetHalfLength();
+  for (G4int i = 0; i < photons; i++)
+  {
+    G4double r = a * std::sqrt(G4UniformRand());
+    G4double phi = twopi * G4UniformRand();
+    G4ThreeVector local(r * std::cos(phi), r * std::sin(phi), h * (2 * G4UniformRand() - 1));
+    G4double cosTheta = G4UniformRand();
+    G4double sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+    phi = twopi * G4UniformRand();
+    G4ThreeVector direction(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+    G4double energy = (2.0 + 1.5 * G4UniformRand()) * eV;
+    fX.push_back(local.x());
+    fY.push_back(local.y());
+    fZ.push_back(local.z());
+    fUX.push_back(direction.x());
+    fUY.push_back(direction.y());
+    fUZ.push_back(direction.z());
+    fEnergy.push_back(energy);
+    fTime.push_back(0.);
+  }
+  Evaluate(photons);
+
+  G4double maxDifference = 0.;
+  for (G4int i = 0; i < photons; i++)
+  {
+    G4ThreeVector position(fX[i], fY[i], fZ[i]), direction(fUX[i], fUY[i], fUZ[i]);
+    G4double length;
+    G4double scalar = fOptics->Transport(position, direction, fEnergy[i], length, 0.)
+                    * (1 - FiberOptics::Reflectivity(direction.z(), fCoreIndex[i], fWindowIndex[i]));
+    maxDifference = std::max(maxDifference, std::fabs(scalar - fProbability[i]));
+  }
+  Clear();
+  return maxDifference;
+}
+
+/// End of file
@@ -0,0 +1,33 @@
+/**
+ * @file /ECal_MT/src/FiberHit.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's hit source code of one readout channel in an event.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "FiberHit.hh"
+
+#include <cfloat>
+
+G4ThreadLocal G4Allocator<FiberHit>* FiberHitAllocator = 0;
+
+/**
+ * @brief Constructor of Fiber hit
+ *
+ * @param channel 	Readout channel (copy number of the fiber)
+ *
+ **/
+
+FiberHit::FiberHit(G4int channel)
+: G4VHit(), fChannel(channel), fEdep(0.), fPhotons(0), fTime(DBL_MAX)
+{}
+
+/// @brief Destructor of Fiber hit
+
+FiberHit::~FiberHit()
+{}
+
+/// End of file
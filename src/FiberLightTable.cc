@@ -0,0 +1,236 @@
+/**
+ * @file /ECal_MT/src/FiberLightTable.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's table of the light transport in a fiber, filled with full optical tracking.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "FiberLightTable.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+  /// FNV-1a hash of a byte range
+  void HashBytes(std::uint64_t& hash, const void* data, std::size_t size)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  }
+
+  void HashValue(std::uint64_t& hash, G4double value) { HashBytes(hash, &value, sizeof(value)); }
+}
+
+/**
+ * @brief Constructor of Fiber light table, every bin is empty
+ *
+ * @param nDepth, nRadius, nCos 	Number of bins of the emission depth, squared radius and direction cosine
+ * @param nTime 		Number of bins of the delay
+ * @param halfLength 	Half length of the fiber
+ * @param coreRadius 	Radius of the core
+ * @param maxTime 		End of the delay distribution
+ *
+ **/
+
+FiberLightTable::FiberLightTable(G4int nDepth, G4int nRadius, G4int nCos, G4int nTime,
+                                 G4double halfLength, G4double coreRadius, G4double maxTime)
+: fNDepth(nDepth), fNRadius(nRadius), fNCos(nCos), fNTime(nTime),
+  fHalfLength(halfLength), fCoreRadius(coreRadius), fMaxTime(maxTime), fKey(0),
+  fEmitted(nDepth * nRadius * nCos, 0.), fDetected(fEmitted.size(), 0.),
+  fTime(fEmitted.size() * nTime, 0.), fTotalEmitted(0.), fTotalDetected(0.)
+{}
+
+/**
+ * @brief Key of the cache file: binning, size of the fiber and optical properties of the materials
+ *
+ * @param materials 	Materials seen by the photons (core, cladding, Detector)
+ *
+ **/
+
+void FiberLightTable::SetMaterials(const std::vector<const G4Material*>& materials)
+{
+  static const char* properties[] = { "RINDEX", "ABSLENGTH", "FASTCOMPONENT", "RAYLEIGH", "MIEHG" };
+
+  std::uint64_t hash = 14695981039346656037ULL;
+  HashBytes(hash, "ECALLUT1", 8);
+  G4int binning[4] = { fNDepth, fNRadius, fNCos, fNTime };
+  HashBytes(hash, binning, sizeof(binning));
+  HashValue(hash, fHalfLength / mm);
+  HashValue(hash, fCoreRadius / mm);
+  HashValue(hash, fMaxTime / ns);
+
+  for (std::size_t m = 0; m < materials.size(); m++)
+  {
+    G4MaterialPropertiesTable* table = materials[m]->GetMaterialPropertiesTable();
+    HashBytes(hash, materials[m]->GetName().c_str(), materials[m]->GetName().size());
+    for (std::size_t p = 0; p < sizeof(properties) / sizeof(properties[0]); p++)
+    {
+      G4MaterialPropertyVector* vector = table ? table->GetProperty(properties[p]) : 0;
+      std::size_t n = vector ? vector->GetVectorLength() : 0;
+      HashBytes(hash, &n, sizeof(n));
+      for (std::size_t i = 0; i < n; i++)
+      {
+        HashValue(hash, vector->Energy(i) / eV);
+        HashValue(hash, (*vector)[i]);
+      }
+    }
+  }
+  fKey = hash;
+}
+
+/// @brief Emptying every bin, the binning and the key are kept
+
+void FiberLightTable::Reset()
+{
+  std::fill(fEmitted.begin(), fEmitted.end(), 0.);
+  std::fill(fDetected.begin(), fDetected.end(), 0.);
+  std::fill(fTime.begin(), fTime.end(), 0.);
+  fTotalEmitted = 0.;
+  fTotalDetected = 0.;
+}
+
+/**
+ * @brief Bin of a photon
+ *
+ * @param position 	Emission point in the fiber (local)
+ * @param direction 	Direction of the photon (local)
+ *
+ **/
+
+G4int FiberLightTable::GetBin(const G4ThreeVector& position, const G4ThreeVector& direction) const
+{
+  G4int i = (G4int)((fHalfLength - position.z()) / (2 * fHalfLength) * fNDepth);
+  G4int j = (G4int)(position.perp2() / (fCoreRadius * fCoreRadius) * fNRadius);
+  G4int k = (G4int)((direction.z() + 1) / 2 * fNCos);
+  i = std::min(std::max(i, 0), fNDepth - 1);
+  j = std::min(std::max(j, 0), fNRadius - 1);
+  k = std::min(std::max(k, 0), fNCos - 1);
+  return (i * fNRadius + j) * fNCos + k;
+}
+
+/**
+ * @brief Counting a photon of a bin reaching the Detector
+ *
+ * @param bin 		Bin of the photon at its emission
+ * @param delay 	Time between the emission and the detection
+ *
+ **/
+
+void FiberLightTable::AddDetected(G4int bin, G4double delay)
+{
+  G4int t = std::min(std::max((G4int)(delay / fMaxTime * fNTime), 0), fNTime - 1);
+  fDetected[bin] += 1;
+  fTime[bin * fNTime + t] += 1;
+}
+
+/// @brief Adding the counts of a worker, the binning is the same on every thread
+
+void FiberLightTable::Merge(const FiberLightTable& other)
+{
+  for (std::size_t i = 0; i < fEmitted.size(); i++) { fEmitted[i] += other.fEmitted[i]; }
+  for (std::size_t i = 0; i < fDetected.size(); i++) { fDetected[i] += other.fDetected[i]; }
+  for (std::size_t i = 0; i < fTime.size(); i++) { fTime[i] += other.fTime[i]; }
+  Count();
+}
+
+/// @brief Totals of the emitted and the detected photons
+
+void FiberLightTable::Count()
+{
+  fTotalEmitted = 0.;
+  fTotalDetected = 0.;
+  for (std::size_t i = 0; i < fEmitted.size(); i++) { fTotalEmitted += fEmitted[i]; }
+  for (std::size_t i = 0; i < fDetected.size(); i++) { fTotalDetected += fDetected[i]; }
+}
+
+/**
+ * @brief Delay of a detected photon of a bin, uniform within the delay bin
+ *
+ * @param bin 		Bin of the photon at its emission
+ * @param random 	Uniform random number
+ *
+ **/
+
+G4double FiberLightTable::SampleTime(G4int bin, G4double random) const
+{
+  const G4double* time = &fTime[bin * fNTime];
+  G4double target = random * fDetected[bin];
+  for (G4int t = 0; t < fNTime; t++)
+  {
+    if (target < time[t]) { return (t + target / time[t]) * fMaxTime / fNTime; }
+    target -= time[t];
+  }
+  return fMaxTime;
+}
+
+/**
+ * @brief Writing the table to a cache file
+ *
+ * @param fileName 	Name of the cache file
+ *
+ **/
+
+G4bool FiberLightTable::Save(const G4String& fileName) const
+{
+  std::FILE* out = std::fopen(fileName.c_str(), "wb");
+  if (!out) { return false; }
+
+  FiberLightTableHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "ECALLUT1", sizeof(header.magic));
+  header.key = fKey;
+  header.nDepth = fNDepth;
+  header.nRadius = fNRadius;
+  header.nCos = fNCos;
+  header.nTime = fNTime;
+
+  std::fwrite(&header, sizeof(header), 1, out);
+  std::fwrite(fEmitted.data(), sizeof(G4double), fEmitted.size(), out);
+  std::fwrite(fDetected.data(), sizeof(G4double), fDetected.size(), out);
+  std::fwrite(fTime.data(), sizeof(G4double), fTime.size(), out);
+  return std::fclose(out) == 0;
+}
+
+/**
+ * @brief Reading the table from a cache file of the same key
+ *
+ * @param fileName 	Name of the cache file
+ *
+ * @return	False if the file is missing, belongs to another geometry or is incomplete (the table stays empty)
+ *
+ **/
+
+G4bool FiberLightTable::Load(const G4String& fileName)
+{
+  std::FILE* in = std::fopen(fileName.c_str(), "rb");
+  if (!in) { return false; }
+
+  FiberLightTableHeader header;
+  G4bool ok = std::fread(&header, sizeof(header), 1, in) == 1
+           && std::memcmp(header.magic, "ECALLUT1", sizeof(header.magic)) == 0
+           && header.key == fKey
+           && header.nDepth == fNDepth && header.nRadius == fNRadius
+           && header.nCos == fNCos && header.nTime == fNTime;
+  ok = ok && std::fread(fEmitted.data(), sizeof(G4double), fEmitted.size(), in) == fEmitted.size();
+  ok = ok && std::fread(fDetected.data(), sizeof(G4double), fDetected.size(), in) == fDetected.size();
+  ok = ok && std::fread(fTime.data(), sizeof(G4double), fTime.size(), in) == fTime.size();
+  std::fclose(in);
+
+  if (ok) { Count(); }
+  else { Reset(); }
+  return ok;
+}
+
+/// End of file
@@ -0,0 +1,153 @@
+/**
+ * @file /ECal_MT/src/FiberOptics.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's analytic light transport in the fiber core.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "FiberOptics.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+  G4MaterialPropertyVector* GetProperty(const G4Material* material, const char* name)
+  {
+    G4MaterialPropertiesTable* table = material ? material->GetMaterialPropertiesTable() : 0;
+    return table ? table->GetProperty(name) : 0;
+  }
+}
+
+/**
+ * @brief Constructor of Fiber optics
+ *
+ * @param coreRadius 	Radius of the core (fiberInterior)
+ * @param halfLength 	Half length of the fiber
+ * @param core 			Material of the core, RINDEX and ABSLENGTH are used
+ * @param cladding 		Material of the cladding, RINDEX is used
+ * @param window 		Material of the Detector behind the end face, RINDEX is used
+ *
+ **/
+
+FiberOptics::FiberOptics(G4double coreRadius, G4double halfLength, const G4Material* core, const G4Material* cladding,
+                         const G4Material* window)
+: fCoreRadius(coreRadius), fHalfLength(halfLength),
+  fCoreIndex(GetProperty(core, "RINDEX")), fCladdingIndex(GetProperty(cladding, "RINDEX")),
+  fAbsorption(GetProperty(core, "ABSLENGTH")), fWindowIndex(GetProperty(window, "RINDEX")),
+  fScattering(GetProperty(core, "RAYLEIGH") || GetProperty(core, "MIEHG"))
+{}
+
+/// @brief Refractive index of the core at a photon energy
+
+G4double FiberOptics::GetRefractiveIndex(G4double energy) const
+{
+  return fCoreIndex ? fCoreIndex->Value(energy) : 1.;
+}
+
+/// @brief Absorption length of the core at a photon energy, infinite without ABSLENGTH
+
+G4double FiberOptics::GetAbsorptionLength(G4double energy) const
+{
+  return fAbsorption ? fAbsorption->Value(energy) : DBL_MAX;
+}
+
+/**
+ * @brief Fresnel reflectivity of unpolarised light
+ *
+ * @param cosIncidence 	Cosine of the angle of incidence
+ * @param n1, n2 		Refractive indices before and behind the interface
+ *
+ **/
+
+G4double FiberOptics::Reflectivity(G4double cosIncidence, G4double n1, G4double n2)
+{
+  G4double sinT = n1 / n2 * std::sqrt(std::max(0., 1 - cosIncidence*cosIncidence));
+  if (sinT >= 1) { return 1.; }  /// total internal reflection
+  G4double cosT = std::sqrt(1 - sinT*sinT);
+  G4double rs = (n1*cosIncidence - n2*cosT) / (n1*cosIncidence + n2*cosT);
+  G4double rp = (n2*cosIncidence - n1*cosT) / (n2*cosIncidence + n1*cosT);
+  return 0.5 * (rs*rs + rp*rp);
+}
+
+/**
+ * @brief Following a photon of the core to the end face at +halfLength
+ *
+ * @param position 		Origin of the photon, replaced by the point on the end face
+ * @param direction 	Direction of the photon, replaced by the direction at the end face
+ * @param energy 		Energy of the photon
+ * @param length 		Path length to the end face
+ * @param threshold 	The transport stops once the probability is not above it (the photon is lost)
+ *
+ * @return	Probability of reaching the end face
+ *
+ **/
+
+G4double FiberOptics::Transport(G4ThreeVector& position, G4ThreeVector& direction, G4double energy,
+                                G4double& length, G4double threshold) const
+{
+  length = 0;
+  G4double uz = direction.z();
+  if (uz <= 0) { return 0.; }
+
+  length = (fHalfLength - position.z()) / uz;
+  G4double probability = std::exp(-length / GetAbsorptionLength(energy));
+  if (probability <= threshold) { return probability; }
+
+  /// motion in the cross section: unit direction (dx, dy) and the projected path
+  G4double sinTheta = std::sqrt(std::max(0., 1 - uz*uz));
+  G4double x = position.x(), y = position.y(), dx = 0, dy = 0;
+  if (sinTheta > 0) { dx = direction.x() / sinTheta; dy = direction.y() / sinTheta; }
+  G4double transverse = length * sinTheta;
+
+  G4double b = x*dx + y*dy;
+  G4double c = x*x + y*y - fCoreRadius*fCoreRadius;
+  G4double wall = -b + std::sqrt(std::max(0., b*b - c));   /// distance to the first reflection
+  if (transverse <= wall)
+  {
+    x += transverse*dx;
+    y += transverse*dy;
+  }
+  else
+  {
+    x += wall*dx;
+    y += wall*dy;
+    G4double nx = x / fCoreRadius, ny = y / fCoreRadius;
+    G4double cosNormal = std::min(1., std::max(0., dx*nx + dy*ny));
+    G4double chord = 2 * fCoreRadius * cosNormal;            /// same length between all reflections
+    G4double nReflections = (chord > 0) ? 1 + std::floor((transverse - wall) / chord) : 1;
+
+    G4double nCladding = fCladdingIndex ? fCladdingIndex->Value(energy) : 1.;
+    probability *= std::pow(Reflectivity(sinTheta*cosNormal, GetRefractiveIndex(energy), nCladding), nReflections);
+    if (probability <= threshold) { return probability; }
+
+    G4double spin = (x*dy - y*dx >= 0) ? 1 : -1;
+    dx -= 2*cosNormal*nx;
+    dy -= 2*cosNormal*ny;
+
+    /// every further reflection turns the point and the direction by the angle of the chord
+    G4double turn = spin * (nReflections - 1) * 2 * std::asin(cosNormal);
+    G4double cosTurn = std::cos(turn), sinTurn = std::sin(turn);
+    G4double px = x, pdx = dx;
+    x = cosTurn*px - sinTurn*y;
+    y = sinTurn*px + cosTurn*y;
+    dx = cosTurn*pdx - sinTurn*dy;
+    dy = sinTurn*pdx + cosTurn*dy;
+
+    G4double rest = std::max(0., transverse - wall - (nReflections - 1)*chord);
+    x += rest*dx;
+    y += rest*dy;
+  }
+
+  position.set(x, y, fHalfLength);
+  direction.set(dx*sinTheta, dy*sinTheta, uz);
+  return probability;
+}
+
+/// End of file
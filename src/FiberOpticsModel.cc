@@ -0,0 +1,102 @@
+/**
+ * @file /ECal_MT/src/FiberOpticsModel.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's fast simulation model of the optical photons in the fibers.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "FiberOpticsModel.hh"
+#include "FiberOptics.hh"
+#include "FiberLightTable.hh"
+#include "DetectorSD.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+/**
+ * @brief Constructor of Fiber optics model, built on every thread
+ *
+ * @param name 		Name of the model
+ * @param region 	Envelope of the fibers
+ * @param optics 	Light transport of the core, shared by the threads
+ * @param table 	Light table of full tracking, shared by the threads (0: analytic transport)
+ * @param detectorSD 	Readout of the Detector of this thread, counting the photons of the table
+ *
+ **/
+
+FiberOpticsModel::FiberOpticsModel(const G4String& name, G4Region* region, const FiberOptics* optics,
+                                   const FiberLightTable* table, DetectorSD* detectorSD)
+: G4VFastSimulationModel(name, region), fOptics(optics), fTable(table), fDetectorSD(detectorSD)
+{}
+
+/// @brief Destructor of Fiber optics model
+
+FiberOpticsModel::~FiberOpticsModel()
+{}
+
+/// @brief Only optical photons are transported by the model
+
+G4bool FiberOpticsModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return &particle == G4OpticalPhoton::OpticalPhotonDefinition();
+}
+
+/// @brief Triggered at the creation of the photon, a moved photon is tracked normally
+
+G4bool FiberOpticsModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  if (fTable && fTable->IsEmpty()) { return false; } /// the table is being filled with full tracking
+  return fastTrack.GetPrimaryTrack()->GetCurrentStepNumber() == 1;
+}
+
+/// @brief Killing the photon or moving it to the end face of its fiber
+
+void FiberOpticsModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  G4ThreeVector position = fastTrack.GetPrimaryTrackLocalPosition();
+  G4ThreeVector direction = fastTrack.GetPrimaryTrackLocalDirection();
+  G4double energy = track->GetKineticEnergy();
+
+  if (fTable)
+  {
+    /// photons of the cladding never reach the Detector, the table holds the core
+    if (fOptics->IsInCore(position))
+    {
+      G4int bin = fTable->GetBin(position, direction);
+      if (G4UniformRand() < fTable->GetProbability(bin))
+      {
+        fDetectorSD->AddPhoton(track->GetPosition(), track->GetGlobalTime() + fTable->SampleTime(bin, G4UniformRand()),
+                               energy);
+      }
+    }
+    fastStep.KillPrimaryTrack();
+    return;
+  }
+
+  G4double length;
+  G4double random = G4UniformRand();
+  if (!fOptics->IsInCore(position) || fOptics->Transport(position, direction, energy, length, random) <= random)
+  {
+    fastStep.KillPrimaryTrack();
+    return;
+  }
+
+  /// stepping back along the path, so the end face is crossed by the tracking
+  const G4double backStep = 1*nm;
+  position -= direction * (backStep / direction.z());
+  length -= backStep / direction.z();
+
+  fastStep.ProposePrimaryTrackFinalPosition(position);
+  fastStep.ProposePrimaryTrackFinalMomentumDirection(direction);
+  fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + length * fOptics->GetRefractiveIndex(energy) / c_light);
+  fastStep.ProposePrimaryTrackPathLength(length);
+}
+
+/// End of file
@@ -0,0 +1,42 @@
+/**
+ * @file /ECal_MT/src/FiberParameterisation.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's parameterisation source code of the fiber grid.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "FiberParameterisation.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ThreeVector.hh"
+
+/**
+ * @brief Constructor of Fiber parameterisation
+ *
+ * @param nFiber 	Number of fibers in one line
+ * @param pitch 	Distance of fiber centers
+ *
+ **/
+
+FiberParameterisation::FiberParameterisation(G4int nFiber, G4double pitch)
+: G4VPVParameterisation(), fFiber(nFiber), fPitch(pitch)
+{}
+
+/// @brief Destructor of Fiber parameterisation
+
+FiberParameterisation::~FiberParameterisation()
+{}
+
+/// @brief Position of fiber copyNo in the Tank
+
+void FiberParameterisation::ComputeTransformation(const G4int copyNo, G4VPhysicalVolume* physVol) const
+{
+  G4int i = copyNo / fFiber;
+  G4int j = copyNo % fFiber;
+  physVol->SetTranslation(G4ThreeVector((i*fPitch)-((fFiber-1)*(fPitch/2)), (j*fPitch)-((fFiber-1)*(fPitch/2)), 0.));
+  physVol->SetRotation(0);
+}
+
+/// End of file
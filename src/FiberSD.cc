@@ -0,0 +1,97 @@
+/**
+ * @file /ECal_MT/src/FiberSD.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's sensitive detector source code of the fiber cores.
+ * Geant4 calls it only for steps starting in a fiber core, every other volume costs nothing here.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "FiberSD.hh"
+#include "EventAction.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4SDManager.hh"
+#include "G4EventManager.hh"
+
+#include <algorithm>
+
+/**
+ * @brief Constructor of Fiber SD
+ *
+ * @param name 					Name of the sensitive detector
+ * @param hitsCollectionName 	Name of the collection of energy deposits per fiber
+ * @param nFiber 				Number of fibers in one line (channels 0 ... nFiber^2-1)
+ * @param placement 			Way the fiber grid is built
+ *
+ **/
+
+FiberSD::FiberSD(const G4String& name, const G4String& hitsCollectionName,
+                 G4int nFiber, FiberPlacement placement)
+: G4VSensitiveDetector(name), fHitsCollection(0), fHitIndex(nFiber * nFiber, -1),
+  fFiber(nFiber), fPlacement(placement), fEventAction(0)
+{
+  collectionName.insert(hitsCollectionName);
+}
+
+/// @brief Destructor of Fiber SD
+
+FiberSD::~FiberSD()
+{}
+
+/// @brief New hits collection of the event
+
+void FiberSD::Initialize(G4HCofThisEvent* hce)
+{
+  fHitsCollection = new FiberHitsCollection(SensitiveDetectorName, collectionName[0]);
+  G4int hcID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
+  hce->AddHitsCollection(hcID, fHitsCollection);
+  std::fill(fHitIndex.begin(), fHitIndex.end(), -1);
+  fEventAction = static_cast<EventAction*>(G4EventManager::GetEventManager()->GetUserEventAction());
+}
+
+/// @brief Hit of a channel, created at its first use in the event
+
+FiberHit* FiberSD::GetHit(G4int channel)
+{
+  if (fHitIndex[channel] < 0) { fHitIndex[channel] = fHitsCollection->insert(new FiberHit(channel)) - 1; }
+  return (*fHitsCollection)[fHitIndex[channel]];
+}
+
+/**
+ * @brief Channel of the fiber core of a step
+ *
+ * Placement: copy number of the core. Parameterised: copy number of the cladding holding it.
+ * Replica: replica numbers of the cell (j) and of the column (i) around the cladding.
+ *
+ **/
+
+G4int FiberSD::GetChannel(const G4VTouchable* touchable) const
+{
+  switch (fPlacement)
+  {
+    case kFiberReplica:       return touchable->GetReplicaNumber(3) * fFiber + touchable->GetReplicaNumber(2);
+    case kFiberParameterised: return touchable->GetCopyNumber(1);
+    default:                  return touchable->GetCopyNumber();
+  }
+}
+
+/// @brief Scoring a step and adding its energy deposit to the hit of its fiber
+
+G4bool FiberSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  fEventAction->ScoreStep(step);
+
+  G4double edep = step->GetTotalEnergyDeposit();
+  if (edep == 0.) { return false; } /// optical photons end here
+
+  G4int channel = GetChannel(step->GetPreStepPoint()->GetTouchable());
+  if (channel < 0 || channel >= (G4int)fHitIndex.size()) { return false; }
+
+  GetHit(channel)->AddEdep(edep);
+  return true;
+}
+
+/// End of file
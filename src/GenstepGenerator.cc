@@ -0,0 +1,272 @@
+/**
+ * @file /ECal_MT/src/GenstepGenerator.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's generator of the optical photons of recorded gensteps.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "GenstepGenerator.hh"
+#include "G4Event.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4Poisson.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  /// Cerenkov photons per length and energy of a unit charge at sin^2 = 1 (G4Cerenkov)
+  const G4double kCerenkovFactor = 369.81 / (eV * cm);
+
+  G4double GetConstProperty(G4MaterialPropertiesTable* table, const char* name, G4double value)
+  {
+    return table->ConstPropertyExists(name) ? table->GetConstProperty(name) : value;
+  }
+}
+
+/**
+ * @brief Optical properties of a material, prepared at its first genstep
+ *
+ * @param material 	Material of the genstep in the current geometry
+ *
+ **/
+
+const GenstepGenerator::MaterialOptics& GenstepGenerator::GetOptics(const G4Material* material)
+{
+  std::map<const G4Material*, MaterialOptics>::iterator found = fOptics.find(material);
+  if (found != fOptics.end()) { return found->second; }
+
+  MaterialOptics& optics = fOptics[material];
+  optics.rindex = 0;
+  optics.maxIndex = 0.;
+  optics.yield = 0.;
+  optics.resolutionScale = 1.;
+  optics.yieldRatio = 1.;
+
+  G4MaterialPropertiesTable* table = material->GetMaterialPropertiesTable();
+  if (!table) { return optics; }
+
+  optics.rindex = table->GetProperty("RINDEX");
+  for (std::size_t i = 0; optics.rindex && i < optics.rindex->GetVectorLength(); i++)
+  {
+    optics.maxIndex = std::max(optics.maxIndex, (*optics.rindex)[i]);
+  }
+
+  optics.yield = GetConstProperty(table, "SCINTILLATIONYIELD", 0.);
+  optics.resolutionScale = GetConstProperty(table, "RESOLUTIONSCALE", 1.);
+  optics.yieldRatio = GetConstProperty(table, "YIELDRATIO", 1.);
+
+  static const char* components[2][2] = { { "FASTCOMPONENT", "FASTTIMECONSTANT" },
+                                          { "SLOWCOMPONENT", "SLOWTIMECONSTANT" } };
+  for (G4int c = 0; c < 2; c++)
+  {
+    G4MaterialPropertyVector* vector = table->GetProperty(components[c][0]);
+    if (!vector || vector->GetVectorLength() == 0) { continue; }
+
+    Spectrum spectrum;
+    spectrum.timeConstant = GetConstProperty(table, components[c][1], 0.);
+    G4double sum = 0.;
+    for (std::size_t i = 0; i < vector->GetVectorLength(); i++)
+    {
+      if (i > 0) { sum += 0.5 * ((*vector)[i] + (*vector)[i-1]) * (vector->Energy(i) - vector->Energy(i-1)); }
+      spectrum.energy.push_back(vector->Energy(i));
+      spectrum.integral.push_back(sum);
+    }
+    if (sum > 0) { optics.components.push_back(spectrum); }
+  }
+  return optics;
+}
+
+/**
+ * @brief Mean number of Cerenkov photons per length
+ *
+ * @param optics 		Properties of the material
+ * @param betaInverse 	1/beta of the particle
+ * @param charge 		Charge of the particle (eplus)
+ *
+ **/
+
+G4double GenstepGenerator::CerenkovPhotonsPerLength(const MaterialOptics& optics, G4double betaInverse,
+                                                    G4double charge) const
+{
+  if (!optics.rindex || betaInverse >= optics.maxIndex) { return 0.; }
+
+  /// integral of sin^2 = 1 - 1/(beta n)^2 over the energies above the threshold
+  G4double sum = 0.;
+  const G4MaterialPropertyVector& rindex = *optics.rindex;
+  for (std::size_t i = 1; i < rindex.GetVectorLength(); i++)
+  {
+    G4double n1 = rindex[i-1], n2 = rindex[i];
+    G4double s1 = std::max(0., 1 - betaInverse*betaInverse / (n1*n1));
+    G4double s2 = std::max(0., 1 - betaInverse*betaInverse / (n2*n2));
+    sum += 0.5 * (s1 + s2) * (rindex.Energy(i) - rindex.Energy(i-1));
+  }
+  return kCerenkovFactor * charge * charge * sum;
+}
+
+/**
+ * @brief Generating the optical photons of a genstep
+ *
+ * @param genstep 	Recorded step
+ * @param material 	Material of the step in the current geometry
+ * @param weight 	Photon weight, 1/weight of the photons is generated
+ * @param event 	Event getting the photons as primaries
+ *
+ * @return	Number of generated photons
+ *
+ **/
+
+G4int GenstepGenerator::GeneratePhotons(const GenstepRecord& genstep, const G4Material* material,
+                                        G4int weight, G4Event* event)
+{
+  const MaterialOptics& optics = GetOptics(material);
+  return Scintillation(genstep, optics, weight, event) + Cerenkov(genstep, optics, weight, event);
+}
+
+/// @brief Isotropic scintillation photons along the step, delayed by the decay of their component;
+/// the recorded edep is already the visible energy where Birks' law was active, no saturation is applied again
+
+G4int GenstepGenerator::Scintillation(const GenstepRecord& genstep, const MaterialOptics& optics,
+                                      G4int weight, G4Event* event)
+{
+  if (optics.yield <= 0 || optics.components.empty() || genstep.edep <= 0) { return 0; }
+
+  G4double mean = optics.yield * genstep.edep * MeV / weight;
+  G4int photons;
+  if (mean > 10.)
+  {
+    photons = (G4int)(G4RandGauss::shoot(mean, optics.resolutionScale * std::sqrt(mean)) + 0.5);
+  }
+  else { photons = (G4int)G4Poisson(mean); }
+  if (photons <= 0) { return 0; }
+
+  G4ThreeVector start(genstep.x * mm, genstep.y * mm, genstep.z * mm);
+  G4ThreeVector delta(genstep.dx * mm, genstep.dy * mm, genstep.dz * mm);
+
+  G4int generated = 0;
+  for (std::size_t c = 0; c < optics.components.size(); c++)
+  {
+    const Spectrum& spectrum = optics.components[c];
+    G4int n = photons;
+    if (optics.components.size() > 1)
+    {
+      G4int fast = (G4int)(std::min(optics.yieldRatio, 1.) * photons);
+      n = (c == 0) ? fast : photons - fast;
+    }
+
+    for (G4int i = 0; i < n; i++)
+    {
+      /// energy from the inverse of the cumulative spectrum
+      G4double target = G4UniformRand() * spectrum.integral.back();
+      std::size_t k = std::lower_bound(spectrum.integral.begin(), spectrum.integral.end(), target)
+                      - spectrum.integral.begin();
+      k = std::min(std::max(k, (std::size_t)1), spectrum.integral.size() - 1);
+      G4double width = spectrum.integral[k] - spectrum.integral[k-1];
+      G4double f = width > 0 ? (target - spectrum.integral[k-1]) / width : 0.;
+      G4double energy = spectrum.energy[k-1] + f * (spectrum.energy[k] - spectrum.energy[k-1]);
+
+      G4double cosTheta = 1 - 2 * G4UniformRand();
+      G4double sinTheta = std::sqrt((1 - cosTheta) * (1 + cosTheta));
+      G4double phi = twopi * G4UniformRand();
+      G4ThreeVector direction(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+
+      phi = twopi * G4UniformRand();
+      G4ThreeVector perpendicular = direction.orthogonal().unit();
+      G4ThreeVector polarization = std::cos(phi) * perpendicular + std::sin(phi) * direction.cross(perpendicular);
+
+      G4double along = G4UniformRand();
+      G4double time = genstep.time * ns + along * genstep.deltaTime * ns
+                    - spectrum.timeConstant * std::log(G4UniformRand());
+      AddPhoton(event, start + along * delta, time, energy, direction, polarization);
+      generated++;
+    }
+  }
+  return generated;
+}
+
+/// @brief Cerenkov photons on the cone around the step, linear change of the yield along it
+
+G4int GenstepGenerator::Cerenkov(const GenstepRecord& genstep, const MaterialOptics& optics,
+                                 G4int weight, G4Event* event)
+{
+  if (!optics.rindex || genstep.charge == 0 || genstep.preBeta <= 0 || genstep.postBeta <= 0) { return 0; }
+
+  G4ThreeVector start(genstep.x * mm, genstep.y * mm, genstep.z * mm);
+  G4ThreeVector delta(genstep.dx * mm, genstep.dy * mm, genstep.dz * mm);
+  G4double length = delta.mag();
+  if (length <= 0) { return 0; }
+
+  G4double beta = 0.5 * (genstep.preBeta + genstep.postBeta);
+  G4double betaInverse = 1 / beta;
+  G4double mean1 = CerenkovPhotonsPerLength(optics, 1 / genstep.preBeta, genstep.charge);
+  G4double mean2 = CerenkovPhotonsPerLength(optics, 1 / genstep.postBeta, genstep.charge);
+  G4double mean = 0.5 * (mean1 + mean2) * length / weight;
+  if (mean <= 0 || betaInverse >= optics.maxIndex) { return 0; }
+
+  G4int photons = (G4int)G4Poisson(mean);
+  const G4MaterialPropertyVector& rindex = *optics.rindex;
+  G4double eMin = rindex.Energy(0);
+  G4double eMax = rindex.Energy(rindex.GetVectorLength() - 1);
+  G4double maxCos = betaInverse / optics.maxIndex;
+  G4double maxSin2 = (1 - maxCos) * (1 + maxCos);
+  G4ThreeVector axis = delta / length;
+
+  for (G4int i = 0; i < photons; i++)
+  {
+    G4double energy, cosTheta, sin2Theta;
+    do
+    {
+      energy = eMin + G4UniformRand() * (eMax - eMin);
+      cosTheta = betaInverse / rindex.Value(energy);
+      sin2Theta = (1 - cosTheta) * (1 + cosTheta);
+    }
+    while (G4UniformRand() * maxSin2 > sin2Theta);
+
+    G4double sinTheta = std::sqrt(std::max(0., sin2Theta));
+    G4double phi = twopi * G4UniformRand();
+    G4ThreeVector direction(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+    G4ThreeVector polarization(cosTheta * std::cos(phi), cosTheta * std::sin(phi), -sinTheta);
+    direction.rotateUz(axis);
+    polarization.rotateUz(axis);
+
+    /// position along the step following the linear change of the yield
+    G4double along, yield;
+    do
+    {
+      along = G4UniformRand();
+      yield = mean1 - along * (mean1 - mean2);
+    }
+    while (G4UniformRand() * std::max(mean1, mean2) > yield);
+
+    AddPhoton(event, start + along * delta, genstep.time * ns + along * genstep.deltaTime * ns,
+              energy, direction, polarization);
+  }
+  return photons;
+}
+
+/// @brief One primary optical photon in its own vertex
+
+void GenstepGenerator::AddPhoton(G4Event* event, const G4ThreeVector& position, G4double time, G4double energy,
+                                 const G4ThreeVector& direction, const G4ThreeVector& polarization)
+{
+  G4PrimaryParticle* photon = new G4PrimaryParticle(G4OpticalPhoton::Definition());
+  photon->SetMomentumDirection(direction);
+  photon->SetKineticEnergy(energy);
+  photon->SetPolarization(polarization.x(), polarization.y(), polarization.z());
+
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(position, time);
+  vertex->SetPrimary(photon);
+  event->AddPrimaryVertex(vertex);
+}
+
+/// End of file
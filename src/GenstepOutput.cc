@@ -0,0 +1,113 @@
+/**
+ * @file /ECal_MT/src/GenstepOutput.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's writer of the optical photon generating steps.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "GenstepOutput.hh"
+#include "G4AutoLock.hh"
+#include "G4Material.hh"
+
+#include <cstring>
+
+GenstepOutput* GenstepOutput::fInstance = 0;
+
+/// @brief Constructor of Genstep output
+
+GenstepOutput::GenstepOutput()
+: fFile(0), fEvents(0), fRecords(0), fRunning(false)
+{
+  fInstance = this;
+}
+
+/// @brief Destructor of Genstep output
+
+GenstepOutput::~GenstepOutput()
+{
+  Stop();
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/**
+ * @brief Opening the genstep file of a run
+ *
+ * @param fileName 	Name of the file
+ *
+ **/
+
+void GenstepOutput::Start(const G4String& fileName)
+{
+  Stop();
+
+  fFileName = fileName;
+  fFile = std::fopen(fFileName.c_str(), "wb");
+  if (!fFile)
+  {
+    G4Exception("GenstepOutput::Start()", "ECal005", FatalException,
+                ("Cannot open " + fFileName).c_str());
+    return;
+  }
+
+  GenstepFileHeader header;
+  std::memcpy(header.magic, "ECALGEN1", sizeof(header.magic));
+  header.recordSize = sizeof(GenstepRecord);
+  std::fwrite(&header, sizeof(header), 1, fFile);
+
+  /// the index of a material in the table is the material of the records
+  const G4MaterialTable* materials = G4Material::GetMaterialTable();
+  std::uint32_t count = materials->size();
+  std::fwrite(&count, sizeof(count), 1, fFile);
+  for (std::size_t i = 0; i < materials->size(); i++)
+  {
+    const G4String& name = (*materials)[i]->GetName();
+    std::uint32_t length = name.size();
+    std::fwrite(&length, sizeof(length), 1, fFile);
+    std::fwrite(name.c_str(), 1, length, fFile);
+  }
+
+  fEvents = 0;
+  fRecords = 0;
+  fRunning.store(true, std::memory_order_release);
+}
+
+/// @brief Closing the file after the last event of the run
+
+void GenstepOutput::Stop()
+{
+  if (!fFile) { return; }
+
+  fRunning.store(false, std::memory_order_release);
+  std::fclose(fFile);
+  fFile = 0;
+
+  G4cout << G4endl << " Genstep output (" << fFileName << "): " << fRecords << " gensteps in "
+         << fEvents << " events" << G4endl;
+}
+
+/**
+ * @brief Writing the gensteps of an event
+ *
+ * @param eventID 	ID of the event
+ * @param records 	Gensteps of the event in the order of the steps
+ *
+ **/
+
+void GenstepOutput::WriteEvent(G4int eventID, const std::vector<GenstepRecord>& records)
+{
+  G4AutoLock lock(&fMutex);
+  if (!fFile) { return; }
+
+  GenstepEventHeader header;
+  header.eventID = eventID;
+  header.nRecords = records.size();
+  std::fwrite(&header, sizeof(header), 1, fFile);
+  if (!records.empty()) { std::fwrite(records.data(), sizeof(GenstepRecord), records.size(), fFile); }
+  fEvents++;
+  fRecords += records.size();
+}
+
+/// End of file
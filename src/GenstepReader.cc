@@ -0,0 +1,124 @@
+/**
+ * @file /ECal_MT/src/GenstepReader.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's reader of the optical photon generating steps.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "GenstepReader.hh"
+#include "G4AutoLock.hh"
+#include "G4Material.hh"
+
+#include <algorithm>
+#include <cstring>
+
+GenstepReader* GenstepReader::fInstance = 0;
+
+/// @brief Constructor of Genstep reader
+
+GenstepReader::GenstepReader()
+: fFile(0)
+{
+  fInstance = this;
+}
+
+/// @brief Destructor of Genstep reader
+
+GenstepReader::~GenstepReader()
+{
+  Close();
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/**
+ * @brief Opening a genstep file and indexing its events
+ *
+ * @param fileName 	Name of the file written by GenstepOutput
+ *
+ * @return	False if the file is missing or is not a genstep file of this build
+ *
+ **/
+
+G4bool GenstepReader::Open(const G4String& fileName)
+{
+  Close();
+
+  fFileName = fileName;
+  fFile = std::fopen(fFileName.c_str(), "rb");
+  if (!fFile) { return false; }
+
+  GenstepFileHeader header;
+  std::uint32_t count = 0;
+  G4bool ok = std::fread(&header, sizeof(header), 1, fFile) == 1
+           && std::memcmp(header.magic, "ECALGEN1", sizeof(header.magic)) == 0
+           && header.recordSize == sizeof(GenstepRecord)
+           && std::fread(&count, sizeof(count), 1, fFile) == 1;
+
+  for (std::uint32_t i = 0; ok && i < count; i++)
+  {
+    std::uint32_t length = 0;
+    ok = std::fread(&length, sizeof(length), 1, fFile) == 1;
+    std::vector<char> name(length);
+    ok = ok && (length == 0 || std::fread(name.data(), 1, length, fFile) == length);
+    if (ok) { fMaterials.push_back(G4Material::GetMaterial(G4String(name.begin(), name.end()), false)); }
+  }
+
+  GenstepEventHeader event;
+  while (ok && std::fread(&event, sizeof(event), 1, fFile) == 1)
+  {
+    EventBlock block;
+    block.eventID = event.eventID;
+    block.nRecords = event.nRecords;
+    block.offset = std::ftell(fFile);
+    fEvents.push_back(block);
+    ok = std::fseek(fFile, (long)(event.nRecords * sizeof(GenstepRecord)), SEEK_CUR) == 0;
+  }
+  std::sort(fEvents.begin(), fEvents.end());
+
+  if (!ok) { Close(); }
+  return ok;
+}
+
+/// @brief Closing the file, the index is dropped
+
+void GenstepReader::Close()
+{
+  if (fFile) { std::fclose(fFile); }
+  fFile = 0;
+  fMaterials.clear();
+  fEvents.clear();
+}
+
+/**
+ * @brief Reading the gensteps of an event
+ *
+ * @param index 	Index of the event in the order of the recorded event IDs
+ * @param records 	Gensteps of the event, replaced
+ *
+ * @return	False if the file has no such event
+ *
+ **/
+
+G4bool GenstepReader::ReadEvent(G4int index, std::vector<GenstepRecord>& records)
+{
+  records.clear();
+  if (index < 0 || index >= (G4int)fEvents.size()) { return false; }
+
+  const EventBlock& block = fEvents[index];
+  records.resize(block.nRecords);
+  if (block.nRecords == 0) { return true; }
+
+  G4AutoLock lock(&fMutex);
+  if (!fFile || std::fseek(fFile, block.offset, SEEK_SET) != 0
+      || std::fread(records.data(), sizeof(GenstepRecord), records.size(), fFile) != records.size())
+  {
+    records.clear();
+    return false;
+  }
+  return true;
+}
+
+/// End of file
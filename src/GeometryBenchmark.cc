@@ -0,0 +1,116 @@
+/**
+ * @file /ECal_MT/src/GeometryBenchmark.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's benchmark of geometry optimisation and navigation.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "GeometryBenchmark.hh"
+#include "G4GeometryManager.hh"
+#include "G4Navigator.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+#include <unistd.h>
+
+/// @brief Resident memory of the process from /proc/self/statm
+
+G4double GeometryBenchmark::ResidentMemory()
+{
+  std::ifstream statm("/proc/self/statm");
+  long pages = 0, resident = 0;
+  if (!(statm >> pages >> resident)) { return 0.; }
+  return resident * (G4double)sysconf(_SC_PAGESIZE) / (1024. * 1024.);
+}
+
+/**
+ * @brief Running the benchmark and printing one "GeometryBenchmark" line
+ *
+ * @param world 	World volume of the closed geometry
+ * @param label 	Layout of the geometry, first column of the result
+ * @param center 	Center of the sampled box (Tank)
+ * @param halfSize 	Half size of the sampled box
+ * @param nPoints 	Number of located points and of followed rays
+ *
+ **/
+
+void GeometryBenchmark::Run(G4VPhysicalVolume* world, const G4String& label,
+                            const G4ThreeVector& center, const G4ThreeVector& halfSize, G4int nPoints)
+{
+  G4GeometryManager* geometry = G4GeometryManager::GetInstance();
+  G4Timer timer;
+
+  /// voxelisation of the whole geometry
+  geometry->OpenGeometry();
+  G4double memory = ResidentMemory();
+  timer.Start();
+  geometry->CloseGeometry(true);
+  timer.Stop();
+  G4double closeTime = timer.GetRealElapsed();
+  G4double closeMemory = ResidentMemory() - memory;
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  std::vector<G4ThreeVector> points(nPoints), directions(nPoints);
+  for (G4int n = 0; n < nPoints; n++)
+  {
+    points[n] = center + G4ThreeVector((2*G4UniformRand()-1)*halfSize.x(),
+                                       (2*G4UniformRand()-1)*halfSize.y(),
+                                       (2*G4UniformRand()-1)*halfSize.z());
+    G4double cosTheta = 2*G4UniformRand()-1, phi = twopi*G4UniformRand();
+    G4double sinTheta = std::sqrt(1 - cosTheta*cosTheta);
+    directions[n] = G4ThreeVector(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+  }
+
+  /// locating random points from scratch
+  timer.Start();
+  for (G4int n = 0; n < nPoints; n++) { navigator.LocateGlobalPointAndSetup(points[n], 0, false, true); }
+  timer.Stop();
+  G4double locateTime = timer.GetRealElapsed();
+
+  /// following straight rays boundary by boundary until they leave the Tank
+  G4long steps = 0;
+  timer.Start();
+  for (G4int n = 0; n < nPoints; n++)
+  {
+    G4ThreeVector point = points[n];
+    const G4ThreeVector& direction = directions[n];
+    navigator.LocateGlobalPointAndSetup(point, &direction, false, false);
+    for (G4int k = 0; k < 10000; k++)
+    {
+      G4double safety;
+      G4double step = navigator.ComputeStep(point, direction, kInfinity, safety);
+      if (step >= kInfinity) { break; }
+      point += step * direction;
+      navigator.SetGeometricallyLimitedStep();
+      navigator.LocateGlobalPointAndSetup(point, &direction, true);
+      steps++;
+
+      G4ThreeVector local = point - center;
+      if (std::fabs(local.x()) > halfSize.x() || std::fabs(local.y()) > halfSize.y() ||
+          std::fabs(local.z()) > halfSize.z()) { break; }
+    }
+  }
+  timer.Stop();
+  G4double rayTime = timer.GetRealElapsed();
+
+  G4cout
+    << G4endl
+    << " GeometryBenchmark " << label
+    << " close_s " << closeTime
+    << " close_MB " << closeMemory
+    << " rss_MB " << ResidentMemory()
+    << " locate_us " << (nPoints ? locateTime / nPoints * 1e6 : 0.)
+    << " step_us " << (steps ? rayTime / steps * 1e6 : 0.)
+    << " steps_per_ray " << (nPoints ? (G4double)steps / nPoints : 0.) << G4endl;
+}
+
+/// End of file
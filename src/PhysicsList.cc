@@ -10,6 +10,8 @@
  **/
 
 #include "PhysicsList.hh"
+#include "DetectorConstruction.hh"
+#include "G4RunManager.hh"
 #include "globals.hh"
 
 #include "G4DecayPhysics.hh"
@@ -50,9 +52,23 @@
 #include "G4HadronPhysicsQGS_BIC.hh"
 
 #include "G4UnitsTable.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4EmParameters.hh"
+#include "G4UImanager.hh"
+#include "G4StateManager.hh"
+#include "G4Timer.hh"
+#include "Randomize.hh"
+#include "Run.hh"
+#include "EventSeeder.hh"
 #include "G4SystemOfUnits.hh"
 
 #include "StepMax.hh"
+#include "TrackKiller.hh"
+#include "RegionLimits.hh"
+
+#include <algorithm>
+#include <sstream>
 
 G4ThreadLocal G4int PhysicsList::fVerboseLevel = 1;
 G4ThreadLocal G4int PhysicsList::fMaxNumPhotonStep = 30;
@@ -62,17 +78,28 @@ G4ThreadLocal G4OpAbsorption* PhysicsList::fAbsorptionProcess = 0;
 G4ThreadLocal G4OpRayleigh* PhysicsList::fRayleighScatteringProcess = 0;
 G4ThreadLocal G4OpMieHG* PhysicsList::fMieHGScatteringProcess = 0;
 G4ThreadLocal G4OpBoundaryProcess* PhysicsList::fBoundaryProcess = 0;
+G4ThreadLocal G4FastSimulationManagerProcess* PhysicsList::fFastSimulationProcess = 0;
+
+/// CutEx presets: range cut, lower end of the cut energies and atomic de-excitation (fluo, Auger, PIXE)
+
+const CutPreset PhysicsList::fCutPresets[] = {
+  { 0.1*mm, 1*keV,   true,  true,  true  },
+  { 0.1*mm, 10*keV,  true,  false, false },
+  { 1*mm,   100*keV, true,  false, false },
+  { 1*mm,   100*keV, false, false, false }
+};
+const G4int PhysicsList::fNumberOfCutPresets = sizeof(fCutPresets) / sizeof(fCutPresets[0]);
 
 /**
  * @brief Constructor of Physics list
  * 
  * @param inPhysList	Name of Hadronic physics list
- * @param fCut			Select of deexcitation settings
+ * @param fCut			CutEx preset of production cuts and deexcitation settings (fCutPresets)
  * 
  **/
 
 PhysicsList::PhysicsList(G4String inPhysList, G4int fCut)
- : G4VModularPhysicsList(),fEmPhysicsList(0),fDecay(0)
+ : G4VModularPhysicsList(),fEmPhysicsList(0),fDecay(0),fMessenger(0)
 {
   fCutForParticle=2000;
 
@@ -80,13 +107,38 @@ PhysicsList::PhysicsList(G4String inPhysList, G4int fCut)
 
   G4LossTableManager::Instance();
   defaultCutValue = fCutForParticle*micrometer;
+  fLowEnergyEnd = 1000*eV;
+  if (scut >= 0 && scut < fNumberOfCutPresets) { defaultCutValue = fCutPresets[scut].cut; }
+  else
+  {
+    G4ExceptionDescription description;
+    description << "CutEx " << scut << " is not a preset (0-" << fNumberOfCutPresets - 1 << "), the cut is "
+                << G4BestUnit(defaultCutValue, "Length") << " without atomic de-excitation.";
+    G4Exception("PhysicsList::PhysicsList()", "ECal007", JustWarning, description);
+  }
+  fCutForParticle = defaultCutValue/micrometer;
   fCutForGamma     = defaultCutValue;
   fCutForElectron  = defaultCutValue;
   fCutForPositron  = defaultCutValue;
   fCutForProton    = defaultCutValue;
-  fCutForElectron  = defaultCutValue;
   SetVerboseLevel(1);
 
+  fMessenger = new G4GenericMessenger(this, "/ECal/physics/", "Physics settings");
+  fMessenger->DeclareMethod("cutPreset", &PhysicsList::SetCutPreset)
+    .SetGuidance("CutEx preset: production cuts, their energy range and the atomic de-excitation,")
+    .SetGuidance("0: 0.1 mm fluo+Auger+PIXE, 1: 0.1 mm fluo, 2: 1 mm fluo, 3: 1 mm no de-excitation")
+    .SetParameterName("preset", false)
+    .SetRange("preset >= 0 && preset <= 3")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fMessenger->DeclareMethod("benchmarkPresets", &PhysicsList::BenchmarkPresets)
+    .SetGuidance("Runs the same events with every CutEx preset and prints the CPU time per event")
+    .SetGuidance("and the mean energy deposit, then the current preset is restored")
+    .SetParameterName("events", true)
+    .SetDefaultValue("100")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+
 
   AddPhysicsList("emstandard_opt0");
   AddPhysicsList(inPhysList);
@@ -101,6 +153,7 @@ PhysicsList::PhysicsList(G4String inPhysList, G4int fCut)
 
 PhysicsList::~PhysicsList()
 {
+  delete fMessenger;
   delete fDecay;
   delete fParticleList;
   delete fEmPhysicsList;
@@ -156,54 +209,13 @@ void PhysicsList::ConstructProcess()
     
     ConstructOp();
 
-    G4double lowEnergyEnd=1000*eV;
-      
-      /// Deexcitation
-      G4VAtomDeexcitation* de = new G4UAtomicDeexcitation();
-      de->SetFluo(false);
-      de->SetAuger(false);
-      de->SetPIXE(false);
-
-      switch(scut){
-      case 0:
-        fCutForParticle=pow(10,2);
-        de->SetFluo(true);
-        de->SetAuger(true);
-        de->SetPIXE(true);
-        lowEnergyEnd=1*keV;
-        break;
-
-      case 1:
-        fCutForParticle=pow(10,2);
-        de->SetFluo(true);
-        de->SetAuger(false);
-        de->SetPIXE(false);
-        lowEnergyEnd=10*keV;
-        break;
-
-      case 2:
-        fCutForParticle=pow(10,3);
-        de->SetFluo(true);
-        de->SetAuger(false);
-        de->SetPIXE(false);
-        lowEnergyEnd=100*keV;
-        break;
-
-      case 3:
-        fCutForParticle=pow(10,3);
-        de->SetFluo(false);
-        de->SetAuger(false);
-        de->SetPIXE(false);
-        lowEnergyEnd=100*keV;
-        break;
-
-      }
-
-    G4LossTableManager::Instance()->SetAtomDeexcitation(de);
-    G4ProductionCutsTable::GetProductionCutsTable()->SetEnergyRange(lowEnergyEnd, 1*GeV);
+    /// Deexcitation, the flags are read from G4EmParameters at initialization
+    G4LossTableManager::Instance()->SetAtomDeexcitation(new G4UAtomicDeexcitation());
+    ApplyCutPreset();
   
     SetCuts();
     AddStepMax();
+    AddTrackKiller();
     
     fParticleList->ConstructProcess();
     for(size_t i=0; i<fHadronPhys.size(); i++) {
@@ -378,21 +390,32 @@ void PhysicsList::AddPhysicsList(const G4String& name)
   }
 }
 
-/// @brief Defining Optical physics processes
+/**
+ * @brief Defining Optical physics processes
+ *
+ * With a photon weight N (/ECal/optics/photonWeight) the scintillation yield is scaled
+ * by 1/N here and the Cerenkov photons are thinned to 1/N by StackingAction.
+ *
+ **/
 
 void PhysicsList::ConstructOp()
 {
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  G4int photonWeight = detector ? detector->GetPhotonWeight() : 1;
+
   fCerenkovProcess = new G4Cerenkov("Cerenkov");
   fCerenkovProcess->SetMaxNumPhotonsPerStep(fMaxNumPhotonStep);
   fCerenkovProcess->SetMaxBetaChangePerStep(10.0);
   fCerenkovProcess->SetTrackSecondariesFirst(true);
   fScintillationProcess = new G4Scintillation("Scintillation");
-  fScintillationProcess->SetScintillationYieldFactor(1.);
+  fScintillationProcess->SetScintillationYieldFactor(1. / photonWeight);
   fScintillationProcess->SetTrackSecondariesFirst(true);
   fAbsorptionProcess = new G4OpAbsorption();
   fRayleighScatteringProcess = new G4OpRayleigh();
   fMieHGScatteringProcess = new G4OpMieHG();
   fBoundaryProcess = new G4OpBoundaryProcess();
+  fFastSimulationProcess = new G4FastSimulationManagerProcess(); /// FiberOpticsModel, idle without the "Fibers" region
 
   fCerenkovProcess->SetVerboseLevel(fVerboseLevel);
   fScintillationProcess->SetVerboseLevel(fVerboseLevel);
@@ -429,6 +452,7 @@ void PhysicsList::ConstructOp()
       pmanager->AddDiscreteProcess(fRayleighScatteringProcess);
       pmanager->AddDiscreteProcess(fMieHGScatteringProcess);
       pmanager->AddDiscreteProcess(fBoundaryProcess);
+      pmanager->AddDiscreteProcess(fFastSimulationProcess);
     }
   }
 }
@@ -489,13 +513,152 @@ void PhysicsList::SetCuts()
   SetCutValue(fCutForPositron, "e+");
   SetCutValue(fCutForProton, "proton");
 
+  /// regions of DetectorConstruction, each gets cuts of its own which /ECal/cuts/ changes later
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (detector)
+  {
+    SetRegionCut("Absorber", detector->GetAbsorberCut());
+    SetRegionCut("Fibers", detector->GetFiberCut());
+    SetRegionCut("Photodetector", detector->GetPhotodetectorCut());
+  }
+
   if (verboseLevel>0) { DumpCutValuesTable(); }
 }
 
-/// @brief Setting step limitation
+/**
+ * @brief Setting the production cuts of a region
+ *
+ * @param regionName 	Name of the region, nothing happens before the geometry is built
+ * @param cut 			Range cut of gamma, e-, e+ and proton, 0: the default cuts
+ *
+ **/
+
+void PhysicsList::SetRegionCut(const G4String& regionName, G4double cut)
+{
+  if (!G4RegionStore::GetInstance()->GetRegion(regionName, false)) { return; }
+
+  SetCutValue(cut > 0 ? cut : fCutForGamma, "gamma", regionName);
+  SetCutValue(cut > 0 ? cut : fCutForElectron, "e-", regionName);
+  SetCutValue(cut > 0 ? cut : fCutForPositron, "e+", regionName);
+  SetCutValue(cut > 0 ? cut : fCutForProton, "proton", regionName);
+}
+
+/**
+ * @brief Selecting a CutEx preset
+ *
+ * Between runs the cuts are set again and the physics tables are rebuilt at the next run.
+ *
+ * @param preset 	Index of fCutPresets
+ *
+ **/
+
+void PhysicsList::SetCutPreset(G4int preset)
+{
+  if (preset < 0 || preset >= fNumberOfCutPresets) { return; }
+
+  scut = preset;
+  defaultCutValue = fCutPresets[scut].cut;
+  fCutForParticle = defaultCutValue/micrometer;
+  fCutForGamma = fCutForElectron = fCutForPositron = fCutForProton = defaultCutValue;
+
+  if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+  {
+    ApplyCutPreset();
+    SetCuts();
+    G4UImanager::GetUIpointer()->ApplyCommand("/run/physicsModified"); /// broadcast to the workers
+  }
+}
+
+/// @brief Energy range of the production cuts and atomic de-excitation of the current preset (master only)
+
+void PhysicsList::ApplyCutPreset()
+{
+  if (!G4Threading::IsMasterThread()) { return; }
+
+  G4bool valid = scut >= 0 && scut < fNumberOfCutPresets;
+  fLowEnergyEnd = valid ? fCutPresets[scut].lowEnergyEnd : 1000*eV;
+
+  G4EmParameters* parameters = G4EmParameters::Instance();
+  parameters->SetFluo(valid && fCutPresets[scut].fluo);
+  parameters->SetAuger(valid && fCutPresets[scut].auger);
+  parameters->SetPixe(valid && fCutPresets[scut].pixe);
+
+  G4ProductionCutsTable::GetProductionCutsTable()->SetEnergyRange(fLowEnergyEnd, 1*GeV);
+}
+
+/**
+ * @brief Running the same events with every CutEx preset
+ *
+ * Every preset starts from the same event index, so the presets see the same events. The CPU time
+ * (all threads) per event and the mean energy deposit in the Tank and the fibers and in the fiber
+ * cores are compared with the finest preset (0).
+ *
+ * @param events 	Events per preset
+ *
+ **/
+
+void PhysicsList::BenchmarkPresets(G4int events)
+{
+  if (events <= 0) { return; }
+
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  G4int current = scut;
+  EventSeeder* seeder = EventSeeder::Instance();
+  G4long firstEvent = seeder ? seeder->GetFirstEvent() : 0;
+  std::vector<G4double> cpu, edep, fiberEdep;
+
+  for (G4int i = 0; i < fNumberOfCutPresets; i++)
+  {
+    SetCutPreset(i);
+    if (seeder) { seeder->SetFirstEvent(firstEvent); }
+
+    G4Timer timer;
+    timer.Start();
+    runManager->BeamOn(events);
+    timer.Stop();
+
+    const Run* run = static_cast<const Run*>(runManager->GetCurrentRun());
+    G4int n = std::max(1, run->GetNumberOfEvent());
+    cpu.push_back((timer.GetUserElapsed() + timer.GetSystemElapsed()) / n);
+    edep.push_back(run->GetCalorimeterEdep() / n);
+    fiberEdep.push_back(run->GetFiberEdep() / n);
+  }
+  SetCutPreset(current);
+
+  G4cout << G4endl << " CutEx preset benchmark, " << events << " events per preset:" << G4endl;
+  for (G4int i = 0; i < fNumberOfCutPresets; i++)
+  {
+    const CutPreset& preset = fCutPresets[i];
+    G4cout << " CutEx " << i << " (cut " << G4BestUnit(preset.cut, "Length") << ", cuts above "
+           << G4BestUnit(preset.lowEnergyEnd, "Energy") << ", fluo " << preset.fluo << " Auger " << preset.auger
+           << " PIXE " << preset.pixe << "): " << 1000. * cpu[i] << " ms per event (x" << cpu[0] / cpu[i]
+           << "), edep " << G4BestUnit(edep[i], "Energy") << " ("
+           << (edep[0] > 0 ? 100. * (edep[i] / edep[0] - 1) : 0.) << " %), fiber cores "
+           << G4BestUnit(fiberEdep[i], "Energy") << " ("
+           << (fiberEdep[0] > 0 ? 100. * (fiberEdep[i] / fiberEdep[0] - 1) : 0.) << " %)" << G4endl;
+  }
+}
+
+/**
+ * @brief Setting step limitation
+ *
+ * StepMax is registered only if a region or volume has a step limit (/ECal/stepMax/), and only for
+ * the particles of /ECal/stepMax/particles; with /ECal/stepMax/everywhere for every charged particle
+ * as before, to compare the cost.
+ *
+ **/
 
 void PhysicsList::AddStepMax()
 {
+  const RegionLimits* limits = RegionLimits::Instance();
+  G4bool everywhere = limits && limits->IsStepMaxEverywhere();
+  if (!limits || (!everywhere && !limits->HasStepLimits())) { return; }
+
+  std::istringstream in(limits->GetStepMaxParticles());
+  std::vector<G4String> names;
+  std::string name;
+  while (in >> name) { names.push_back(name); }
 
   StepMax* stepMaxProcess = new StepMax();
 
@@ -505,7 +668,9 @@ void PhysicsList::AddStepMax()
       G4ParticleDefinition* particle = particleIterator->value();
       G4ProcessManager* pmanager = particle->GetProcessManager();
 
-      if (stepMaxProcess->IsApplicable(*particle))
+      G4bool listed = everywhere ||
+        std::find(names.begin(), names.end(), particle->GetParticleName()) != names.end();
+      if (listed && stepMaxProcess->IsApplicable(*particle))
         {
           pmanager ->AddDiscreteProcess(stepMaxProcess);
         }
@@ -513,4 +678,26 @@ void PhysicsList::AddStepMax()
 }
 
 
+/// @brief Killing escaped, late and slow tracks (/ECal/killer/ thresholds, readout window, World)
+
+void PhysicsList::AddTrackKiller()
+{
+  const RegionLimits* limits = RegionLimits::Instance();
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (!limits || !detector) { return; }
+
+  TrackKiller* killerProcess = new TrackKiller(limits, detector);
+
+  auto particleIterator=GetParticleIterator();
+  particleIterator->reset();
+  while ((*particleIterator)()){
+      G4ParticleDefinition* particle = particleIterator->value();
+      if (killerProcess->IsApplicable(*particle))
+        {
+          particle->GetProcessManager()->AddDiscreteProcess(killerProcess);
+        }
+  }
+}
+
 /// End of file
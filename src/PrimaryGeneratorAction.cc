@@ -10,6 +10,12 @@
  **/
 
 #include "PrimaryGeneratorAction.hh"
+#include "DetectorConstruction.hh"
+#include "FiberLightTable.hh"
+#include "GenstepReader.hh"
+#include "BeamProfile.hh"
+#include "EventSeeder.hh"
+#include "ExternalEventReader.hh"
 
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
@@ -20,29 +26,38 @@
 #include "G4ParticleDefinition.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
-#include <cstdlib>
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4IonTable.hh"
+#include <algorithm>
 
 /** @brief Constructor of Primary generator action
  *
  *  @param E0 			Kinetic energy of particle
  *  @param Particle 	Type of particle
  *  @param Fiber		Fiber number parameter
- *  @param fBoxMuller	Option to Box-Muller algorithm for inhomogeneous particle shower
+ *  @param fDetector 	Geometry, tells whether the run fills the fiber light table
  * 
  **/
 
 PrimaryGeneratorAction::PrimaryGeneratorAction(G4double E0, G4String Particle, G4int Fiber)
 : G4VUserPrimaryGeneratorAction(),
-  fParticleGun(0),fParticle(Particle),fEnergy(E0), fFiber(Fiber), fBoxMuller(true)
+  fDetector(0), fParticleGun(0),fParticle(Particle),fEnergy(E0), fFiber(Fiber)
 {
+  fDetector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
   G4int n_particle = 1;   ///particles per event
   fParticleGun  = new G4ParticleGun(n_particle);
 
   G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable(); /// default particle kinematic
   G4ParticleDefinition* particle = particleTable->FindParticle(fParticle);
   fParticleGun->SetParticleDefinition(particle);
-  
-  if(fBoxMuller==false){fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));}
+  fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
 
   fParticleGun->SetParticleEnergy(fEnergy*GeV);
 }
@@ -58,23 +73,136 @@ PrimaryGeneratorAction::~PrimaryGeneratorAction()
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
-	if(fBoxMuller==true)
+	const EventSeeder* seeder = EventSeeder::Instance();
+	if(seeder) { seeder->SeedEvent(anEvent->GetEventID()); } /// same event with any number of threads
+
+	if(fDetector->NeedsFiberLightTable())
 	{
-	G4double phi, r,rRand,ux,uy;
-	phi=((double)rand()/(double)RAND_MAX)*M_PI*2;
-	rRand=((double)rand()/(double)RAND_MAX);
-	r=0.87*(fFiber/2)*rRand;  
-	ux=r*cos(phi);
-	uy=r*sin(phi);  
-	fParticleGun->SetParticlePosition(G4ThreeVector(ux,uy,0));
-	fParticleGun->GeneratePrimaryVertex(anEvent);
-	fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0,0,1));
+	GenerateLightTablePhotons(anEvent, fDetector->GetFiberLightTable());
+	return;
 	}
-	else
+
+	GenstepReader* reader = GenstepReader::Instance();
+	if(reader && reader->IsOpen())
 	{
-	fParticleGun->SetParticlePosition(G4ThreeVector(0,0,0));
-    fParticleGun->GeneratePrimaryVertex(anEvent);
+	GenerateGenstepPhotons(anEvent, reader);
+	return;
 	}
+
+	ExternalEventReader* events = ExternalEventReader::Instance();
+	if(events && events->IsOpen())
+	{
+	GenerateExternalEvent(anEvent, events);
+	return;
+	}
+
+	G4ThreeVector position, direction(0,0,1);
+	const BeamProfile* beam = BeamProfile::Instance();
+	if(beam) { beam->Sample(position, direction); } /// engine of this thread, no shared state
+	fParticleGun->SetParticlePosition(position);
+	fParticleGun->SetParticleMomentumDirection(direction);
+	fParticleGun->GeneratePrimaryVertex(anEvent);
+}
+
+/**
+ * @brief Optical photons filling the fiber light table
+ *
+ * Uniform in the core of the fiber at the origin of the table, isotropic, at time 0,
+ * energies of the scintillation spectrum (FASTCOMPONENT) of the core.
+ *
+ **/
+
+void PrimaryGeneratorAction::GenerateLightTablePhotons(G4Event* anEvent, const FiberLightTable* table)
+{
+  const G4Material* core = G4Material::GetMaterial("G4_POLYSTYRENE");
+  G4MaterialPropertyVector* spectrum = core->GetMaterialPropertiesTable()->GetProperty("FASTCOMPONENT");
+  G4double maxValue = 0.;
+  for (std::size_t i = 0; i < spectrum->GetVectorLength(); i++) { maxValue = std::max(maxValue, (*spectrum)[i]); }
+  G4double eMin = spectrum->Energy(0);
+  G4double eMax = spectrum->Energy(spectrum->GetVectorLength() - 1);
+
+  for (G4int n = 0; n < kFiberLightPhotonsPerEvent; n++)
+  {
+    G4double r = table->GetCoreRadius() * std::sqrt(G4UniformRand());
+    G4double phi = twopi * G4UniformRand();
+    G4ThreeVector position(r * std::cos(phi), r * std::sin(phi), table->GetHalfLength() * (2 * G4UniformRand() - 1));
+
+    G4double cosTheta = 2 * G4UniformRand() - 1;
+    G4double sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+    phi = twopi * G4UniformRand();
+    G4ThreeVector direction(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+
+    phi = twopi * G4UniformRand();
+    G4ThreeVector perpendicular = direction.orthogonal().unit();
+    G4ThreeVector polarization = std::cos(phi) * perpendicular + std::sin(phi) * direction.cross(perpendicular);
+
+    G4double energy;
+    do { energy = eMin + (eMax - eMin) * G4UniformRand(); }
+    while (G4UniformRand() * maxValue > spectrum->Value(energy));
+
+    G4PrimaryParticle* photon = new G4PrimaryParticle(G4OpticalPhoton::Definition());
+    photon->SetMomentumDirection(direction);
+    photon->SetKineticEnergy(energy);
+    photon->SetPolarization(polarization.x(), polarization.y(), polarization.z());
+
+    G4PrimaryVertex* vertex = new G4PrimaryVertex(table->GetOrigin() + position, 0.);
+    vertex->SetPrimary(photon);
+    anEvent->AddPrimaryVertex(vertex);
+  }
+}
+
+/**
+ * @brief Optical photons of a recorded event (genstep replay)
+ *
+ * Event n of the run replays the n-th recorded event, the shower itself is not simulated.
+ * Gensteps of materials missing from the geometry are skipped.
+ *
+ **/
+
+void PrimaryGeneratorAction::GenerateGenstepPhotons(G4Event* anEvent, GenstepReader* reader)
+{
+  if (!reader->ReadEvent(anEvent->GetEventID(), fGensteps)) { return; } /// beyond the recorded events
+
+  G4int weight = fDetector->GetPhotonWeight();
+  for (std::size_t i = 0; i < fGensteps.size(); i++)
+  {
+    const G4Material* material = reader->GetMaterial(fGensteps[i].material);
+    if (material) { fGenerator.GeneratePhotons(fGensteps[i], material, weight, anEvent); }
+  }
+}
+
+/**
+ * @brief Final state particles of an external generator event
+ *
+ * Event n of the run reads event first+n of the file. All particles share one vertex at the
+ * sampled beam spot, their momenta are turned from +z to the sampled beam direction.
+ * Particles unknown to Geant4 are skipped.
+ *
+ **/
+
+void PrimaryGeneratorAction::GenerateExternalEvent(G4Event* anEvent, ExternalEventReader* reader)
+{
+  if (!reader->ReadEvent(reader->GetFirstEvent() + anEvent->GetEventID(), fExternal)) { return; }
+
+  G4ThreeVector position, direction(0,0,1);
+  const BeamProfile* beam = BeamProfile::Instance();
+  if (beam) { beam->Sample(position, direction); }
+
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(position, 0.);
+  for (std::size_t i = 0; i < fExternal.size(); i++)
+  {
+    G4ParticleDefinition* definition = particleTable->FindParticle(fExternal[i].pdg);
+    if (!definition && fExternal[i].pdg > 1000000000) { definition = G4IonTable::GetIonTable()->GetIon(fExternal[i].pdg); }
+    if (!definition) { continue; }
+
+    G4ThreeVector momentum(fExternal[i].px*GeV, fExternal[i].py*GeV, fExternal[i].pz*GeV);
+    momentum.rotateUz(direction);
+    vertex->SetPrimary(new G4PrimaryParticle(definition, momentum.x(), momentum.y(), momentum.z()));
+  }
+
+  if (vertex->GetNumberOfParticle() > 0) { anEvent->AddPrimaryVertex(vertex); }
+  else { delete vertex; }
 }
 
 /// End of file
@@ -0,0 +1,253 @@
+/**
+ * @file /ECal_MT/src/RegionLimits.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's step limits and track killing thresholds of the regions.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "RegionLimits.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4UserLimits.hh"
+#include "G4UnitsTable.hh"
+
+#include <sstream>
+
+RegionLimits* RegionLimits::fInstance = 0;
+
+/**
+ * @brief Constructor of Region limits
+ *
+ * @param fStepMaxParticles, fStepMaxEverywhere 	Registration of StepMax (/ECal/stepMax/)
+ * @param fKillers 	Thresholds of TrackKiller per region (/ECal/killer/)
+ *
+ **/
+
+RegionLimits::RegionLimits()
+: fStepMaxParticles("e- e+"), fStepMaxEverywhere(false), fStepMaxRegistered(false),
+  fKillerVersion(0), fApplied(false),
+  fStepMaxMessenger(0), fKillerMessenger(0)
+{
+  fInstance = this;
+
+  fStepMaxMessenger = new G4GenericMessenger(this, "/ECal/stepMax/", "Step limitation of regions and volumes");
+  fStepMaxMessenger->DeclareMethod("region", &RegionLimits::SetRegionStepMax)
+    .SetGuidance("Maximum step of the charged particles in a region: name, length and unit, 0 removes it,")
+    .SetGuidance("e.g. Fibers 0.1 mm (regions: Absorber, Fibers, Photodetector)")
+    .SetParameterName("limit", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fStepMaxMessenger->DeclareMethod("volume", &RegionLimits::SetVolumeStepMax)
+    .SetGuidance("Maximum step in a logical volume, before the limit of its region: e.g. fiberInterior 0.05 mm")
+    .SetParameterName("limit", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fStepMaxMessenger->DeclareProperty("particles", fStepMaxParticles)
+    .SetGuidance("Particles the step limitation is registered for (e- e+ by default), the process is")
+    .SetGuidance("registered only if a limit is set before initialization")
+    .SetParameterName("particles", false)
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fStepMaxMessenger->DeclareProperty("everywhere", fStepMaxEverywhere)
+    .SetGuidance("Step limitation registered for every charged particle even without limits (the former")
+    .SetGuidance("setup), to measure the cost of the process")
+    .SetParameterName("everywhere", true)
+    .SetDefaultValue("true")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  fKillerMessenger = new G4GenericMessenger(this, "/ECal/killer/", "Killing of slow and late tracks");
+  fKillerMessenger->DeclareMethod("neutron", &RegionLimits::SetNeutronKiller)
+    .SetGuidance("Neutrons of a region below a kinetic energy or after a global time are killed:")
+    .SetGuidance("region (or all), energy and unit, time and unit, 0: no threshold, e.g. Absorber 1 MeV 500 ns")
+    .SetParameterName("threshold", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fKillerMessenger->DeclareMethod("fragment", &RegionLimits::SetFragmentKiller)
+    .SetGuidance("Nuclear fragments (ions, alpha, d, t, He3) of a region below a kinetic energy or after")
+    .SetGuidance("a global time are stopped, their kinetic energy is deposited on the spot")
+    .SetParameterName("threshold", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fKillerMessenger->DeclareMethod("gamma", &RegionLimits::SetGammaKiller)
+    .SetGuidance("Gammas of a region below a kinetic energy or after a global time are killed")
+    .SetParameterName("threshold", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
+
+/// @brief Destructor of Region limits
+
+RegionLimits::~RegionLimits()
+{
+  delete fStepMaxMessenger;
+  delete fKillerMessenger;
+  for (std::size_t i = 0; i < fUserLimits.size(); i++) { delete fUserLimits[i]; }
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/// @brief Maximum step of a region (name, length and unit)
+
+void RegionLimits::SetRegionStepMax(const G4String& limit)
+{
+  AddStepLimit(fRegionStepMax, limit, true);
+}
+
+/// @brief Maximum step of a logical volume (name, length and unit)
+
+void RegionLimits::SetVolumeStepMax(const G4String& limit)
+{
+  AddStepLimit(fVolumeStepMax, limit, false);
+}
+
+/**
+ * @brief Applying the step limits read so far to the regions and volumes of the new geometry
+ *
+ * PhysicsList::AddStepMax decides the registration of StepMax the same way, so later limits can
+ * warn when it is missing. TrackKiller is always registered, thresholds can be set at any time.
+ *
+ **/
+
+void RegionLimits::Apply()
+{
+  for (std::size_t i = 0; i < fRegionStepMax.size(); i++)
+  {
+    ApplyStepLimit(fRegionStepMax[i].first, fRegionStepMax[i].second, true);
+  }
+  for (std::size_t i = 0; i < fVolumeStepMax.size(); i++)
+  {
+    ApplyStepLimit(fVolumeStepMax[i].first, fVolumeStepMax[i].second, false);
+  }
+
+  fStepMaxRegistered = HasStepLimits() || fStepMaxEverywhere;
+  fApplied = true;
+}
+
+/**
+ * @brief Reading a step limit, it is applied now if the geometry is built, otherwise in Apply
+ *
+ * @param limits 	Limits of the regions or of the logical volumes
+ * @param limit 	Name, length and unit
+ * @param region 	The name is a region, not a logical volume
+ *
+ **/
+
+void RegionLimits::AddStepLimit(std::vector<std::pair<G4String, G4double> >& limits,
+                                const G4String& limit, G4bool region)
+{
+  std::istringstream in(limit);
+  std::string name, unit;
+  G4double value;
+  if (!(in >> name >> value >> unit) || value < 0 || !G4UnitDefinition::IsUnitDefined(unit)
+      || G4UnitDefinition::GetCategory(unit) != "Length")
+  {
+    G4ExceptionDescription description;
+    description << "Step limit \"" << limit << "\" is not a name, a length and its unit, the limit is not changed.";
+    G4Exception("RegionLimits::AddStepLimit()", "ECal008", JustWarning, description);
+    return;
+  }
+  G4double step = value * G4UnitDefinition::GetValueOf(unit);
+
+  std::size_t i = 0;
+  while (i < limits.size() && limits[i].first != name) { i++; }
+  if (i == limits.size()) { limits.push_back(std::make_pair(G4String(name), step)); }
+  else { limits[i].second = step; }
+
+  if (!fApplied) { return; }
+  ApplyStepLimit(name, step, region);
+  if (step > 0 && !fStepMaxRegistered)
+  {
+    G4Exception("RegionLimits::AddStepLimit()", "ECal008", JustWarning,
+                "StepMax was not registered at initialization (no step limit yet), the limit has no effect.");
+  }
+}
+
+/**
+ * @brief Setting the G4UserLimits of a region or logical volume read by StepMax
+ *
+ * @param name 		Name of the region or logical volume
+ * @param step 		Maximum step, 0: no limit
+ * @param region 	The name is a region
+ *
+ **/
+
+void RegionLimits::ApplyStepLimit(const G4String& name, G4double step, G4bool region)
+{
+  G4Region* targetRegion = region ? G4RegionStore::GetInstance()->GetRegion(name, false) : 0;
+  G4LogicalVolume* targetVolume = region ? 0 : G4LogicalVolumeStore::GetInstance()->GetVolume(name, false);
+  if (!targetRegion && !targetVolume)
+  {
+    G4ExceptionDescription description;
+    description << (region ? "Region " : "Logical volume ") << name << " does not exist, no step limit is set.";
+    G4Exception("RegionLimits::ApplyStepLimit()", "ECal008", JustWarning, description);
+    return;
+  }
+
+  G4UserLimits* limits = targetRegion ? targetRegion->GetUserLimits() : targetVolume->GetUserLimits();
+  if (!limits)
+  {
+    limits = new G4UserLimits();
+    fUserLimits.push_back(limits);
+    if (targetRegion) { targetRegion->SetUserLimits(limits); }
+    else { targetVolume->SetUserLimits(limits); }
+  }
+  limits->SetMaxAllowedStep(step > 0 ? step : DBL_MAX);
+
+  G4cout << " Step limit of " << (region ? "region " : "volume ") << name << ": ";
+  if (step > 0) { G4cout << G4BestUnit(step, "Length") << G4endl; }
+  else { G4cout << "none" << G4endl; }
+}
+
+/**
+ * @brief Reading the killing thresholds of a category in a region
+ *
+ * @param category 		Neutrons, nuclear fragments or gammas
+ * @param threshold 	Region (or all), kinetic energy and unit, global time and unit
+ *
+ **/
+
+void RegionLimits::AddKiller(KillerCategory category, const G4String& threshold)
+{
+  std::istringstream in(threshold);
+  std::string region, energyUnit, timeUnit;
+  G4double energy, time;
+  if (!(in >> region >> energy >> energyUnit >> time >> timeUnit) || energy < 0 || time < 0
+      || !G4UnitDefinition::IsUnitDefined(energyUnit) || G4UnitDefinition::GetCategory(energyUnit) != "Energy"
+      || !G4UnitDefinition::IsUnitDefined(timeUnit) || G4UnitDefinition::GetCategory(timeUnit) != "Time")
+  {
+    G4ExceptionDescription description;
+    description << "Killing threshold \"" << threshold << "\" is not a region, an energy and a time with units,"
+                << " the thresholds are not changed.";
+    G4Exception("RegionLimits::AddKiller()", "ECal009", JustWarning, description);
+    return;
+  }
+
+  std::size_t i = 0;
+  while (i < fKillers.size() && fKillers[i].region != region) { i++; }
+  if (i == fKillers.size())
+  {
+    RegionKiller killer;
+    killer.region = region;
+    for (G4int j = 0; j < kNumberOfKillerCategories; j++) { killer.threshold[j].energy = killer.threshold[j].time = 0.; }
+    fKillers.push_back(killer);
+  }
+  fKillers[i].threshold[category].energy = energy * G4UnitDefinition::GetValueOf(energyUnit);
+  fKillers[i].threshold[category].time = time * G4UnitDefinition::GetValueOf(timeUnit);
+  fKillerVersion++;
+}
+
+/// @brief A step limit is set, StepMax has to be registered at initialization
+
+G4bool RegionLimits::HasStepLimits() const
+{
+  for (std::size_t i = 0; i < fRegionStepMax.size(); i++) { if (fRegionStepMax[i].second > 0) { return true; } }
+  for (std::size_t i = 0; i < fVolumeStepMax.size(); i++) { if (fVolumeStepMax[i].second > 0) { return true; } }
+  return false;
+}
+
+/// End of file
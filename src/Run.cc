@@ -11,28 +11,270 @@
 
 
 #include "Run.hh"
+#include "DetectorConstruction.hh"
+#include "G4RunManager.hh"
+#include "G4UnitsTable.hh"
 
-/// @brief Constructor of Run
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+/**
+ * @brief Constructor of Run
+ *
+ * @param fProfile 	Longitudinal (30 bins) and lateral (150x150 bins) profiles in the frame of Macro.cc
+ * @param fDetectedPhotons 	Optical photons reaching the Detector in the run
+ * @param fFiberEdep 	Energy deposit in the fiber cores in the run
+ * @param fCalorimeterEdep 	Energy deposit in the Tank and the fibers in the run (the G4PSEnergyDeposit scorer of the Tank plus the fiber hits, summed in EventAction)
+ * @param fLightTable 	Empty copy of the light table if this run fills it
+ * @param fCutPhotons, fCutRejected, fCutRejectedDetected 	Counts of the trapping cut (StackingAction)
+ * @param fEfficiencyPhotons, fEfficiencyKilled 	Counts of the photon detection efficiency (StackingAction or DetectorSD)
+ * @param fThinnedPhotons, fThinnedKilled 	Counts of the Cerenkov thinning of the photon weight (StackingAction)
+ * @param fBatchPhotons, fBatchDetected, fBatches 	Counts of the batch transport (FiberBatchTransport)
+ * @param fLatePhotons, fLateTracks, fLateEnergy 	Tracks killed past the readout window
+ * @param fKilled, fKilledEnergy 	Neutrons, nuclear fragments and gammas killed by TrackKiller
+ *
+ **/
 
 Run::Run()
-: G4Run()
+: G4Run(), fProfile(0), fLightTable(0), fDetectedPhotons(0), fFiberEdep(0.), fCalorimeterEdep(0.),
+  fCutPhotons(0), fCutRejected(0), fCutRejectedDetected(0),
+  fEfficiencyPhotons(0), fEfficiencyKilled(0), fThinnedPhotons(0), fThinnedKilled(0),
+  fBatchPhotons(0), fBatchDetected(0), fBatches(0),
+  fLatePhotons(0), fLateTracks(0), fLateEnergy(0.)
 {
+  for (G4int i = 0; i < kNumberOfKillerCategories; i++) { fKilled[i] = 0; fKilledEnergy[i] = 0.; }
+
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  G4double halfXY = detector->GetFiberPitch() * (detector->GetFiber() + 1) / 2;
+  fProfile = new ShowerProfile(30, detector->GetProfileOrigin(),
+                               detector->GetProfileOrigin() + detector->GetProfileDepth(),
+                               150, halfXY);
+
+  if (detector->NeedsFiberLightTable())
+  {
+    fLightTable = new FiberLightTable(*detector->GetFiberLightTable());
+  }
 } 
 
 /// @brief Destructor of Run
 
 Run::~Run()
-{} 
+{
+  delete fProfile;
+  delete fLightTable;
+} 
  
-/// @brief Void Merge
+/// @brief Merging the profiles of a worker run into the master run
 
 void Run::Merge(const G4Run* run)
 {
   const Run* localRun = static_cast<const Run*>(run);
 
+  fProfile->Merge(*localRun->fProfile);
+  if (fLightTable && localRun->fLightTable) { fLightTable->Merge(*localRun->fLightTable); }
+  fDetectedPhotons += localRun->fDetectedPhotons;
+  fFiberEdep += localRun->fFiberEdep;
+  fCalorimeterEdep += localRun->fCalorimeterEdep;
+  fCutPhotons += localRun->fCutPhotons;
+  fCutRejected += localRun->fCutRejected;
+  fCutRejectedDetected += localRun->fCutRejectedDetected;
+  fEfficiencyPhotons += localRun->fEfficiencyPhotons;
+  fEfficiencyKilled += localRun->fEfficiencyKilled;
+  fThinnedPhotons += localRun->fThinnedPhotons;
+  fThinnedKilled += localRun->fThinnedKilled;
+  fBatchPhotons += localRun->fBatchPhotons;
+  fBatchDetected += localRun->fBatchDetected;
+  fBatches += localRun->fBatches;
+  fLatePhotons += localRun->fLatePhotons;
+  fLateTracks += localRun->fLateTracks;
+  fLateEnergy += localRun->fLateEnergy;
+  for (G4int i = 0; i < kNumberOfKillerCategories; i++)
+  {
+    fKilled[i] += localRun->fKilled[i];
+    fKilledEnergy[i] += localRun->fKilledEnergy[i];
+  }
+  fPhotonsPerEvent.insert(fPhotonsPerEvent.end(),
+                          localRun->fPhotonsPerEvent.begin(), localRun->fPhotonsPerEvent.end());
+
   G4Run::Merge(run); 
 }
 
+/**
+ * @brief Counting the detected photons of a finished event
+ *
+ * @param eventID 	ID of the event
+ * @param photons 	Optical photons of the event reaching the Detector
+ *
+ **/
+
+void Run::AddDetectedPhotons(G4int eventID, G4int photons)
+{
+  fDetectedPhotons += photons;
+  fPhotonsPerEvent.push_back(std::make_pair(eventID, photons));
+}
+
+/**
+ * @brief Writing the detected photons per event and printing their mean and RMS
+ *
+ * @param fileName 	Name of the output file, one "eventID photons" line per event
+ *
+ **/
+
+G4bool Run::WriteDetectedPhotons(const G4String& fileName) const
+{
+  std::vector<std::pair<G4int, G4int> > events(fPhotonsPerEvent);
+  std::sort(events.begin(), events.end()); /// workers finish their events in any order
+
+  G4double sum = 0., sum2 = 0.;
+  std::ofstream out(fileName.c_str());
+  for (std::size_t i = 0; i < events.size(); i++)
+  {
+    out << events[i].first << " " << events[i].second << "\n";
+    sum += events[i].second;
+    sum2 += (G4double)events[i].second * events[i].second;
+  }
+
+  G4double mean = events.empty() ? 0. : sum / events.size();
+  G4double rms = events.empty() ? 0. : std::sqrt(std::max(0., sum2 / events.size() - mean * mean));
+  G4cout
+    << G4endl
+    << " Detected photons: " << fDetectedPhotons << " in " << events.size() << " events"
+    << " (mean " << mean << ", RMS " << rms << " per event)" << G4endl
+    << " Energy deposit in fiber cores: " << G4BestUnit(fFiberEdep, "Energy") << G4endl;
+
+  return out.good();
+}
+
+/**
+ * @brief Printing the sampling fraction and the CPU time of the run
+ *
+ * @param cpuTime 	CPU time of the run summed over the threads
+ *
+ **/
+
+void Run::PrintSamplingFraction(G4double cpuTime) const
+{
+  if (numberOfEvent == 0) { return; }
+
+  G4cout << " Sampling fraction: " << (fCalorimeterEdep > 0 ? fFiberEdep / fCalorimeterEdep : 0.)
+         << " (" << G4BestUnit(fCalorimeterEdep / numberOfEvent, "Energy")
+         << " per event in the Tank and the fibers), CPU time " << cpuTime << " s, "
+         << 1000. * cpuTime / numberOfEvent << " ms per event" << G4endl;
+}
+
+/**
+ * @brief Printing the share of new optical photons outside the trapping cut
+ *
+ * @param validation 	The photons outside the cut were tracked: they should not reach the Detector
+ *
+ **/
+
+void Run::PrintTrappingCut(G4bool validation) const
+{
+  if (fCutPhotons == 0) { return; }
+
+  G4cout << " Trapping cut: " << fCutRejected << " of " << fCutPhotons << " optical photons outside ("
+         << 100. * fCutRejected / fCutPhotons << " %), ";
+  if (validation)
+  {
+    G4cout << "tracked, " << fCutRejectedDetected << " of them detected (detected with the cut: "
+           << fDetectedPhotons - fCutRejectedDetected << ", without: " << fDetectedPhotons << ")" << G4endl;
+  }
+  else { G4cout << "killed at creation" << G4endl; }
+}
+
+/**
+ * @brief Printing the share of optical photons killed by the photon detection efficiency
+ *
+ * @param atCreation 	The efficiency was sampled at the creation of the photons, not at the Detector
+ *
+ **/
+
+void Run::PrintEfficiency(G4bool atCreation) const
+{
+  if (fEfficiencyPhotons == 0) { return; }
+
+  G4cout << " Detection efficiency: " << fEfficiencyKilled << " of " << fEfficiencyPhotons
+         << " optical photons undetected (" << 100. * fEfficiencyKilled / fEfficiencyPhotons << " %), killed "
+         << (atCreation ? "at creation" : "at the Detector") << G4endl;
+}
+
+/**
+ * @brief Printing the biasing of the optical photons
+ *
+ * @param weight 	Weight of the generated photons, the detected photons are already weighted
+ *
+ **/
+
+void Run::PrintPhotonWeight(G4int weight) const
+{
+  if (weight <= 1) { return; }
+
+  G4cout << " Photon weight: " << weight << " (scintillation yield 1/" << weight << ", "
+         << fThinnedPhotons - fThinnedKilled << " of " << fThinnedPhotons << " Cerenkov photons kept)" << G4endl;
+}
+
+/// @brief Printing the photons of the batch transport
+
+void Run::PrintBatchTransport() const
+{
+  if (fBatches == 0) { return; }
+
+  G4cout << " Batch transport: " << fBatchPhotons << " optical photons of the fiber cores in " << fBatches
+         << " batches, " << fBatchDetected << " reaching the Detector ("
+         << 100. * fBatchDetected / fBatchPhotons << " %)" << G4endl;
+}
+
+/**
+ * @brief Printing the tracks killed past the readout window
+ *
+ * @param window 		Readout window, nothing is printed without it
+ * @param threshold 	Kinetic energy below which other tracks are killed too
+ *
+ **/
+
+void Run::PrintTimeWindow(G4double window, G4double threshold) const
+{
+  if (window <= 0) { return; }
+
+  G4cout << " Time window " << G4BestUnit(window, "Time") << ": " << fLatePhotons << " late optical photons";
+  if (threshold > 0)
+  {
+    G4cout << ", " << fLateTracks << " tracks below " << G4BestUnit(threshold, "Energy")
+           << " (" << G4BestUnit(fLateEnergy, "Energy") << ")";
+  }
+  G4cout << " killed" << G4endl;
+}
+
+/**
+ * @brief Printing the tracks killed by TrackKiller and their kinetic energy per event
+ *
+ * Fragments deposit their energy on the spot, the energy of neutrons and gammas is lost:
+ * compared with the energy deposit per event it bounds the bias of the thresholds.
+ *
+ **/
+
+void Run::PrintTrackKiller() const
+{
+  static const char* names[] = { "neutrons", "fragments", "gammas" };
+  G4long killed = 0;
+  for (G4int i = 0; i < kNumberOfKillerCategories; i++) { killed += fKilled[i]; }
+  if (killed == 0) { return; }
+
+  G4cout << " Track killer:";
+  for (G4int i = 0; i < kNumberOfKillerCategories; i++)
+  {
+    if (fKilled[i] == 0) { continue; }
+    G4cout << " " << fKilled[i] << " " << names[i] << " ("
+           << G4BestUnit(fKilledEnergy[i] / std::max(1, numberOfEvent), "Energy") << " per event"
+           << (i == kKillFragment ? " deposited)" : ")");
+  }
+  G4cout << G4endl;
+}
+
 /// End of file
 
 
@@ -10,18 +10,99 @@
  **/
 
 #include "RunAction.hh"
+#include "StepDictionary.hh"
+#include "StepColumnWriter.hh"
+#include "G4Threading.hh"
 
-/// @brief Constructor of Run
+#include <cstdio>
 
-RunAction::RunAction()
-: G4UserRunAction()
+/** @brief Constructor of Run
+ *
+ *  @param eventAction 	Event action of the same worker thread (0 on master)
+ *  @param steppingAction 	Stepping action of the same worker thread, installed only for the runs needing it (0 on master)
+ *  @param fLogSteps 	Step records are written, /ECal/output/steps false keeps the profiles only
+ *  @param fLogChannels 	Per-event channel rows are written (channels.bin)
+ *  @param fLogGensteps 	Optical photon generating steps are written (gensteps.bin)
+ *  @param fReplayFile 	Genstep file whose optical photons are the primaries of the run
+ *  @param fEventFile 	External event file whose final state particles are the primaries of the run
+ *
+ **/
+
+RunAction::RunAction(EventAction* eventAction, SteppingAction* steppingAction)
+: G4UserRunAction(), fEventAction(eventAction), fSteppingAction(steppingAction), fOutput(0), fChannels(0), fGenstepOutput(0), fGenstepReader(0), fBeam(0), fSeeder(0),
+  fEventReader(0), fMessenger(0), fGenstepMessenger(0), fEventMessenger(0), fLogSteps(true), fLogChannels(true), fLogGensteps(false),
+  fFirstEvent(0)
 {   
+  if (G4Threading::IsMasterThread())
+  {
+    fOutput = new StepOutputService();
+    fChannels = new ChannelOutput();
+    fGenstepOutput = new GenstepOutput();
+    fGenstepReader = new GenstepReader();
+
+    const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    fBeam = new BeamProfile(detector->GetFiber(), detector->GetFiberPitch());
+    fSeeder = new EventSeeder(0); /// main sets the master seed
+    fEventReader = new ExternalEventReader();
+
+    fMessenger = new G4GenericMessenger(this, "/ECal/output/", "Output of the simulation");
+    fMessenger->DeclareProperty("steps", fLogSteps)
+      .SetGuidance("Write step records (steps.col) besides the shower profiles (profiles.dat)")
+      .SetParameterName("steps", true)
+      .SetDefaultValue("true")
+      .SetToBeBroadcasted(false);
+    fMessenger->DeclareProperty("channels", fLogChannels)
+      .SetGuidance("Write one row of fiber channels per event (channels.bin)")
+      .SetParameterName("channels", true)
+      .SetDefaultValue("true")
+      .SetToBeBroadcasted(false);
+
+    fGenstepMessenger = new G4GenericMessenger(this, "/ECal/gensteps/", "Optical photon generating steps");
+    fGenstepMessenger->DeclareProperty("record", fLogGensteps)
+      .SetGuidance("Write the scintillation and Cerenkov inputs of every charged step (gensteps.bin)")
+      .SetParameterName("record", true)
+      .SetDefaultValue("true")
+      .SetToBeBroadcasted(false);
+    fGenstepMessenger->DeclareProperty("replay", fReplayFile)
+      .SetGuidance("Generate only the optical photons of a genstep file instead of the showers,")
+      .SetGuidance("event n of the run replays the n-th recorded event; an empty name ends the replay")
+      .SetParameterName("file", true)
+      .SetDefaultValue("")
+      .SetToBeBroadcasted(false);
+
+    fEventMessenger = new G4GenericMessenger(this, "/ECal/events/", "External generator events");
+    fEventMessenger->DeclareProperty("file", fEventFile)
+      .SetGuidance("Fire the final state particles of a HEPEVT text or ECALEVT1 binary file instead of the gun,")
+      .SetGuidance("event n of the run reads event first+n of the file; an empty name returns to the gun")
+      .SetParameterName("file", true)
+      .SetDefaultValue("")
+      .SetToBeBroadcasted(false);
+    fEventMessenger->DeclareProperty("first", fFirstEvent)
+      .SetGuidance("Event of the file read by the first event of the run")
+      .SetParameterName("first", true)
+      .SetDefaultValue("0")
+      .SetRange("first>=0")
+      .SetToBeBroadcasted(false);
+  }
 }
 
 /// @brief Destructor of Run
 
 RunAction::~RunAction()
-{}
+{
+  delete fMessenger;
+  delete fGenstepMessenger;
+  delete fEventMessenger;
+  delete fEventReader;
+  delete fGenstepReader;
+  delete fBeam;
+  delete fSeeder;
+  delete fGenstepOutput;
+  delete fChannels;
+  delete fOutput;
+  delete fSteppingAction; /// never left installed, see EndOfRunAction
+}
 
 /// @brief Generation of Runs
 
@@ -34,6 +115,63 @@ G4Run* RunAction::GenerateRun()
 
 void RunAction::BeginOfRunAction(const G4Run*)
 {
+  if (IsMaster()) { StepDictionary::BuildNames(); } /// IDs of the job, written to the step files
+  StepDictionary::Instance()->Build();              /// pointers of this thread to these IDs
+  fTimer.Start();
+  if (fSeeder) { fSeeder->BeginOfRun(); }
+
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (fSteppingAction && SteppingAction::IsNeeded(detector))
+  {
+    G4RunManager::GetRunManager()->SetUserAction(fSteppingAction); /// the gensteps are started by the master run
+  }
+  if (detector->NeedsFiberLightTable())
+  {
+    if (fOutput && !detector->IsFillingFiberLightTable())
+    {
+      G4Exception("RunAction::BeginOfRunAction()", "ECal014", JustWarning,
+                  "The fiber light table is empty, this run fills it with isotropic photons instead of "
+                  "simulating the beam; use /ECal/optics/fillTable before the first run");
+    }
+    return; /// the run filling the light table has no output
+  }
+
+  if (fOutput && fLogSteps) { fOutput->Start("steps.bin"); } /// workers start after the master
+
+  if (fChannels && fLogChannels)
+  {
+    fChannels->Start("channels.bin", detector->GetFiber());
+  }
+
+  if (fGenstepOutput && fLogGensteps) { fGenstepOutput->Start("gensteps.bin"); }
+
+  if (fGenstepReader)
+  {
+    if (fReplayFile.empty()) { fGenstepReader->Close(); }
+    else if (!fGenstepReader->Open(fReplayFile))
+    {
+      G4Exception("RunAction::BeginOfRunAction()", "ECal006", FatalException,
+                  ("Cannot read gensteps from " + fReplayFile).c_str());
+    }
+    else
+    {
+      G4cout << G4endl << " Genstep replay (" << fReplayFile << "): "
+             << fGenstepReader->GetNumberOfEvents() << " recorded events" << G4endl;
+    }
+  }
+
+  if (fEventReader)
+  {
+    fEventReader->SetFirstEvent(fFirstEvent);
+    if (fEventFile.empty()) { fEventReader->Close(); }
+    else if ((!fEventReader->IsOpen() || fEventReader->GetFileName() != fEventFile)  /// the index of the file is kept
+             && !fEventReader->Open(fEventFile))
+    {
+      G4Exception("RunAction::BeginOfRunAction()", "ECal010", FatalException,
+                  ("Cannot read external events from " + fEventFile).c_str());
+    }
+  }
 }
 
 /// @brief End of Run action
@@ -41,6 +179,80 @@ void RunAction::BeginOfRunAction(const G4Run*)
 void RunAction::EndOfRunAction(const G4Run*)
 {
   Run* run = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  if (fEventAction) { fEventAction->GetStepBuffer()->Flush(); }
+  if (fSteppingAction) { G4RunManager::GetRunManager()->SetUserAction((G4UserSteppingAction*)0); } /// owned here
+  G4long seed = fSeeder ? fSeeder->GetSeed() : 0;
+  G4long firstEvent = fSeeder ? fSeeder->GetFirstEvent() : 0; /// identity of the run in profiles.dat and steps.col
+  if (fSeeder && !run->GetLightTable())
+  {
+    fSeeder->EndOfRun(run->GetNumberOfEvent()); /// the next run continues the event indices, the table fill does not count
+  }
+
+  if (fOutput && run->GetLightTable())
+  {
+    /// every worker has merged its photons, the table is kept for the next runs
+    FiberLightTable* table = detector->GetFiberLightTable();
+    table->Merge(*run->GetLightTable());
+    G4bool saved = table->Save(detector->GetFiberLightTableFile());
+    G4cout
+      << G4endl
+      << " Fiber light table: " << table->GetTotalDetected() << " of " << table->GetTotalEmitted()
+      << " photons detected, " << (saved ? "saved to " : "could not be saved to ")
+      << detector->GetFiberLightTableFile() << G4endl;
+  }
+  else if (fOutput)
+  {
+    /// every worker has merged its run, the profiles are complete
+    run->GetProfile()->Write("profiles.dat", seed, firstEvent, run->GetNumberOfEvent());
+    run->WriteDetectedPhotons("photons.dat");
+    run->PrintTrappingCut(detector->GetTrappingCut() == kTrappingCutValidate);
+    run->PrintEfficiency(detector->GetEfficiencyMode() == kEfficiencyAtCreation);
+    run->PrintPhotonWeight(detector->GetPhotonWeight());
+    run->PrintBatchTransport();
+    run->PrintTimeWindow(detector->GetTimeWindow(), detector->GetLateEnergyThreshold());
+    run->PrintTrackKiller();
+    if (fEventReader->IsOpen()) { fEventReader->Report(); }
+    fTimer.Stop();
+    detector->PrintRegionCuts();
+    run->PrintSamplingFraction(fTimer.GetUserElapsed() + fTimer.GetSystemElapsed());
+    fChannels->Stop();
+    fGenstepOutput->Stop();
+  }
+
+  if (fOutput && fOutput->IsRunning())
+  {
+    /// every worker has finished, the stream is closed and turned into the columnar file
+    fOutput->Stop();
+    fOutput->Report();
+
+    StepColumnGeometry geometry;
+    geometry.nFiber = detector->GetFiber();
+    geometry.fiberPitch = detector->GetFiberPitch();
+    geometry.zOffset = detector->GetProfileOrigin();
+    geometry.maxZ = detector->GetProfileDepth();
+    geometry.seed = seed;
+    geometry.firstEvent = firstEvent;
+    geometry.runEvents = run->GetNumberOfEvent();
+
+    if (fOutput->HasFailed())
+    {
+      G4Exception("RunAction::EndOfRunAction()", "ECal015", JustWarning,
+                  ("Writing " + fOutput->GetFileName() + " failed, it is kept and not converted to steps.col").c_str());
+    }
+    else if (StepColumnWriter::Convert(fOutput->GetFileName(), "steps.col", geometry))
+    {
+      std::remove(fOutput->GetFileName().c_str());
+    }
+    else
+    {
+      G4Exception("RunAction::EndOfRunAction()", "ECal015", JustWarning,
+                  ("Cannot convert " + fOutput->GetFileName() + " to steps.col (truncated or corrupt block, "
+                   "or a failed write), the step file is kept").c_str());
+    }
+  }
   
   if (IsMaster()) {
     G4cout
@@ -0,0 +1,74 @@
+/**
+ * @file /ECal_MT/src/ShowerProfile.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's fixed binning accumulator of the longitudinal and lateral shower profiles.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "ShowerProfile.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+
+/**
+ * @brief Constructor of Shower profile
+ *
+ * @param nZ 		Number of longitudinal bins
+ * @param zMin 		Start of the longitudinal frame (global z)
+ * @param zMax 		End of the longitudinal frame (global z)
+ * @param nXY 		Number of lateral bins along x and y
+ * @param halfXY 	Half width of the lateral frame
+ *
+ **/
+
+ShowerProfile::ShowerProfile(G4int nZ, G4double zMin, G4double zMax, G4int nXY, G4double halfXY)
+: fNZ(nZ), fZMin(zMin), fZMax(zMax), fZScale(nZ / (zMax - zMin)),
+  fNXY(nXY), fHalfXY(halfXY), fXYScale(nXY / (2 * halfXY)),
+  fLongitudinal(nZ, 0.), fLateral(nXY * nXY, 0.)
+{}
+
+/// @brief Adding the bins of a worker, the binning is the same on every thread
+
+void ShowerProfile::Merge(const ShowerProfile& other)
+{
+  for (std::size_t i = 0; i < fLongitudinal.size(); i++) { fLongitudinal[i] += other.fLongitudinal[i]; }
+  for (std::size_t i = 0; i < fLateral.size(); i++) { fLateral[i] += other.fLateral[i]; }
+}
+
+/**
+ * @brief Writing the profiles as text, lengths in cm and energies in MeV
+ *
+ * "run seed firstEvent events" identifies the run (as in the steps.col header), then
+ * "longitudinal nZ 0 depth" and one bin per line (z measured from the start of the frame),
+ * then "lateral nXY -halfXY halfXY" and one row of x bins per y bin.
+ *
+ * @param fileName 		Name of the output file
+ * @param seed 			Master seed of the run
+ * @param firstEvent 	Index of event 0 of the run
+ * @param events 		Number of events of the run
+ *
+ **/
+
+G4bool ShowerProfile::Write(const G4String& fileName, G4long seed, G4long firstEvent, G4long events) const
+{
+  std::ofstream out(fileName.c_str());
+  if (!out) { return false; }
+
+  out << "run " << seed << " " << firstEvent << " " << events << "\n";
+
+  out << "longitudinal " << fNZ << " 0 " << (fZMax - fZMin) / cm << "\n";
+  for (G4int i = 0; i < fNZ; i++) { out << fLongitudinal[i] / MeV << "\n"; }
+
+  out << "lateral " << fNXY << " " << -fHalfXY / cm << " " << fHalfXY / cm << "\n";
+  for (G4int j = 0; j < fNXY; j++)
+  {
+    for (G4int i = 0; i < fNXY; i++) { out << (i ? " " : "") << fLateral[j * fNXY + i] / MeV; }
+    out << "\n";
+  }
+  return out.good();
+}
+
+/// End of file
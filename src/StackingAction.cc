@@ -0,0 +1,143 @@
+/**
+ * @file /ECal_MT/src/StackingAction.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's stacking action killing optical photons which cannot reach the Detector.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "StackingAction.hh"
+#include "FiberOptics.hh"
+#include "FiberBatchTransport.hh"
+#include "DetectorSD.hh"
+#include "PhysicsList.hh"
+#include "G4Track.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "Randomize.hh"
+
+/**
+ * @brief Constructor of Stacking action
+ *
+ * @param eventAction 	Event action of the same worker thread (current run)
+ *
+ **/
+
+StackingAction::StackingAction(EventAction* eventAction)
+: G4UserStackingAction(), fEventAction(eventAction), fDetector(0), fOptics(0),
+  fOpticalPhoton(G4OpticalPhoton::Definition()), fTableRun(false), fCut(kTrappingCutOff),
+  fEfficiency(kEfficiencyOff), fWeight(1), fCerenkov(0), fBatch(0)
+{
+  fDetector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+}
+
+/// @brief Destructor of Stacking action
+
+StackingAction::~StackingAction()
+{
+  delete fBatch;
+}
+
+/// @brief Reading the modes of the cut and of the efficiency, they can be changed between runs
+
+void StackingAction::PrepareNewEvent()
+{
+  fTableRun = fDetector->NeedsFiberLightTable();
+  fCut = fDetector->GetTrappingCut();
+  fEfficiency = fDetector->GetEfficiencyMode();
+  fOptics = fDetector->GetFiberOptics();
+  fWeight = fDetector->GetPhotonWeight();
+  fCerenkov = PhysicsList::GetCerenkovProcess();
+
+  if (!fBatch && fDetector->GetFiberTransport() == kFiberTransportBatch)
+  {
+    /// the transport is fixed at PreInit, the readout of this thread exists from the first event
+    fBatch = new FiberBatchTransport(fOptics);
+    fBatch->SetDetectorSD(static_cast<DetectorSD*>(G4SDManager::GetSDMpointer()->FindSensitiveDetector("detectorSD")));
+  }
+  if (fBatch) { fBatch->Clear(); } /// photons of an aborted event, FlushBatch empties it otherwise
+}
+
+/// @brief Transporting the last photons of the event, called by EventAction before the hits are read
+
+void StackingAction::FlushBatch()
+{
+  if (!fBatch) { return; }
+
+  fBatch->Flush();
+  fEventAction->GetRun()->AddBatchTransport(fBatch->GetPhotons(), fBatch->GetDetected(), fBatch->GetBatches());
+  fBatch->ResetCounts();
+}
+
+/**
+ * @brief Killing a new optical photon which cannot reach the Detector or would not be detected there
+ *
+ * Primary photons of the light table run are never cut, the ones of a genstep replay are. With a photon weight N
+ * only 1/N of the Cerenkov photons is kept (the scintillation yield is already scaled by
+ * PhysicsList), the cheapest test goes first. The trapping cut tests
+ * the position in the frame of the fiber and the direction cosine along the fiber (FiberOptics),
+ * then the photon detection efficiency at the energy of the photon is sampled with the engine
+ * of this thread, so the undetected share of the photons is never tracked. With the batch
+ * transport the remaining photons are collected for FiberBatchTransport instead of tracked.
+ * Any track born past the readout window which DetectorConstruction::IsLate is killed first.
+ *
+ **/
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  G4bool optical = track->GetDefinition() == fOpticalPhoton;
+  if (fDetector->IsLate(track->GetGlobalTime(), optical, track->GetKineticEnergy()))
+  {
+    /// born past the readout window (neutron captures, decays)
+    fEventAction->GetRun()->CountLate(optical, track->GetKineticEnergy());
+    return fKill;
+  }
+
+  if (!optical || (fTableRun && track->GetParentID() == 0)) { return fUrgent; }
+
+  if (fWeight > 1 && track->GetCreatorProcess() == fCerenkov)
+  {
+    G4bool kept = G4UniformRand() * fWeight < 1.;
+    fEventAction->GetRun()->CountThinning(kept);
+    if (!kept) { return fKill; }
+  }
+
+  G4ThreeVector local;
+  if (fCut != kTrappingCutOff || fBatch) { local = fDetector->ToFiberFrame(track->GetPosition()); }
+
+  if (fCut != kTrappingCutOff)
+  {
+    G4bool accepted = fOptics->CanReachDetector(local, track->GetMomentumDirection(), track->GetKineticEnergy());
+    fEventAction->GetRun()->CountTrappingCut(accepted);
+    if (!accepted)
+    {
+      if (fCut != kTrappingCutValidate) { return fKill; }
+      track->SetUserInformation(new OutsideCutInformation()); /// counted by DetectorSD
+    }
+  }
+
+  if (fEfficiency == kEfficiencyAtCreation)
+  {
+    G4bool detected = G4UniformRand() < fDetector->GetDetectionEfficiency(track->GetKineticEnergy());
+    fEventAction->GetRun()->CountEfficiency(detected);
+    if (!detected) { return fKill; }
+  }
+
+  if (fBatch)
+  {
+    /// the photon is transported with the others of the event in batches, photons of the cladding are lost
+    if (fOptics->IsInCore(local))
+    {
+      fBatch->Add(track->GetPosition(), local, track->GetMomentumDirection(), track->GetKineticEnergy(),
+                  track->GetGlobalTime());
+    }
+    return fKill;
+  }
+  return fUrgent;
+}
+
+/// End of file
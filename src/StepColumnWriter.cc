@@ -0,0 +1,144 @@
+/**
+ * @file /ECal_MT/src/StepColumnWriter.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's converter from binary step records to the columnar step file.
+ * Records are decoded block by block and scattered to their columns, so memory use does not grow with the run.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "StepColumnWriter.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cstdio>
+#include <map>
+#include <vector>
+
+/**
+ * @brief Converting a binary step file to a columnar step file
+ *
+ * @param rowFile 		Binary step file written by StepOutputService
+ * @param columnFile 	Name of the columnar file to write
+ * @param geometry 		Constants written to the header
+ *
+ * @return	False if the input cannot be read, a block is truncated or corrupt, or a write fails;
+ *          a partly written output is removed
+ *
+ **/
+
+G4bool StepColumnWriter::Convert(const G4String& rowFile, const G4String& columnFile,
+                                 const StepColumnGeometry& geometry)
+{
+  StepBlockReader in;
+  if (!in.Open(rowFile.c_str())) { return false; }
+  const std::vector<char>& dictionary = in.GetDictionary();
+
+  /// first pass: blocks of every thread in order, number of records and event index
+  std::map<G4int, std::vector<std::pair<long, StepBlockHeader> > > blocks; /// thread -> (offset, header)
+  StepBlockHeader blockHeader;
+  long blockOffset;
+  while (in.NextHeader(blockHeader, blockOffset))
+  {
+    blocks[blockHeader.thread].push_back(std::make_pair(blockOffset, blockHeader));
+  }
+
+  /// records of an event are contiguous within a thread, threads are written one after the other
+  std::vector<StepRecord> records;
+  std::vector<StepEventIndex> events;
+  std::uint64_t nRecords = 0;
+  std::map<G4int, std::vector<std::pair<long, StepBlockHeader> > >::const_iterator thread;
+  for (thread = blocks.begin(); thread != blocks.end(); ++thread)
+  {
+    G4bool newThread = true;
+    for (std::size_t b = 0; b < thread->second.size(); b++)
+    {
+      if (!in.ReadBlock(thread->second[b].second, thread->second[b].first, records)) { return false; }
+      for (std::size_t i = 0; i < records.size(); i++, nRecords++)
+      {
+        if (newThread || events.back().eventID != records[i].eventID)
+        {
+          StepEventIndex event = { records[i].eventID, nRecords, 0 };
+          events.push_back(event);
+          newThread = false;
+        }
+        events.back().count++;
+      }
+    }
+  }
+
+  /// layout of the output file
+  StepColumnHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "ECALCOL2", sizeof(header.magic));
+  header.nColumns = kStepColumnCount;
+  header.nFiber = geometry.nFiber;
+  header.nRecords = nRecords;
+  header.nEvents = events.size();
+  header.indexOffset = sizeof(StepColumnHeader) + kStepColumnCount*sizeof(StepColumnInfo);
+  header.dictionaryOffset = header.indexOffset + events.size()*sizeof(StepEventIndex);
+  header.dictionarySize = dictionary.size();
+  header.fiberPitch = geometry.fiberPitch / cm;
+  header.zOffset = geometry.zOffset / cm;
+  header.maxZ = geometry.maxZ / cm;
+  header.seed = geometry.seed;
+  header.firstEvent = geometry.firstEvent;
+  header.runEvents = geometry.runEvents;
+
+  StepColumnInfo columns[kStepColumnCount];
+  std::uint64_t offset = header.dictionaryOffset + header.dictionarySize;
+  for (std::uint32_t c = 0; c < kStepColumnCount; c++)
+  {
+    offset = (offset + kStepColumnAlign - 1) / kStepColumnAlign * kStepColumnAlign;
+    std::memset(&columns[c], 0, sizeof(StepColumnInfo));
+    std::strncpy(columns[c].name, kStepColumnFields[c].name, sizeof(columns[c].name));
+    columns[c].type = kStepColumnFields[c].type;
+    columns[c].size = 4;
+    columns[c].offset = offset;
+    offset += nRecords * 4;
+  }
+
+  std::FILE* out = std::fopen(columnFile.c_str(), "wb");
+  if (!out) { return false; }
+  G4bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1
+    && std::fwrite(columns, sizeof(StepColumnInfo), kStepColumnCount, out) == kStepColumnCount
+    && std::fwrite(events.data(), sizeof(StepEventIndex), events.size(), out) == events.size()
+    && std::fwrite(dictionary.data(), 1, dictionary.size(), out) == dictionary.size();
+
+  /// second pass: scattering every block to the columns in the same order
+  std::vector<char> column;
+  std::uint64_t done = 0;
+  for (thread = blocks.begin(); thread != blocks.end() && ok; ++thread)
+  {
+    for (std::size_t b = 0; b < thread->second.size() && ok; b++)
+    {
+      ok = in.ReadBlock(thread->second[b].second, thread->second[b].first, records);
+      std::size_t n = records.size();
+      column.resize(n * 4);
+      for (std::uint32_t c = 0; c < kStepColumnCount && ok; c++)
+      {
+        const char* field = reinterpret_cast<const char*>(records.data()) + kStepColumnFields[c].offset;
+        for (std::size_t i = 0; i < n; i++)
+        {
+          std::memcpy(&column[i*4], field + i*sizeof(StepRecord), 4);
+        }
+        ok = std::fseek(out, columns[c].offset + done*4, SEEK_SET) == 0
+          && std::fwrite(column.data(), 4, n, out) == n;
+      }
+      done += n;
+    }
+  }
+
+  /// padding the file to the end of the last column
+  if (ok && (nRecords == 0 || std::ftell(out) < (long)offset))
+  {
+    ok = std::fseek(out, offset > 0 ? offset - 1 : 0, SEEK_SET) == 0 && std::fputc(0, out) != EOF;
+  }
+
+  ok = (std::fclose(out) == 0) && ok;
+  if (!ok) { std::remove(columnFile.c_str()); }
+  return ok;
+}
+
+/// End of file
@@ -0,0 +1,179 @@
+/**
+ * @file /ECal_MT/src/StepDictionary.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's dictionary of particle, process and volume IDs for step records.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "StepDictionary.hh"
+
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4LogicalVolumeStore.hh"
+
+#include <algorithm>
+
+G4ThreadLocal StepDictionary* StepDictionary::fInstance = 0;
+std::vector<G4String> StepDictionary::fParticleNames;
+std::vector<G4String> StepDictionary::fProcessNames;
+std::vector<G4String> StepDictionary::fVolumeNames;
+
+/// @brief Dictionary of the current thread
+
+StepDictionary* StepDictionary::Instance()
+{
+  if (!fInstance) { fInstance = new StepDictionary(); }
+  return fInstance;
+}
+
+/// @brief Constructor of Step dictionary
+
+StepDictionary::StepDictionary()
+: fLastParticle(0), fLastParticleID(0), fLastProcess(0), fLastProcessID(0), fGenericIonID(0),
+  fWorld(0), fDetector(0)
+{}
+
+/**
+ * @brief Sorted unique names of the objects, index is the ID
+ *
+ * @param names 	Names, "none" first
+ * @param entries 	Name of every object, the same name may belong to more objects
+ *
+ **/
+
+void StepDictionary::Sort(std::vector<G4String>& names, const Entries& entries)
+{
+  names.assign(1, "none");
+  for (std::size_t i = 0; i < entries.size(); i++) { names.push_back(entries[i].first); }
+  std::sort(names.begin() + 1, names.end());
+  names.erase(std::unique(names.begin() + 1, names.end()), names.end());
+}
+
+/**
+ * @brief Giving the objects of this thread the IDs of their names
+ *
+ * @param names 	Master names, index is the ID
+ * @param map 		Pointer to ID map, objects with a name not in the list are left out (ID 0)
+ * @param entries 	Name of every object of this thread
+ *
+ **/
+
+void StepDictionary::Assign(const std::vector<G4String>& names, IDMap& map, const Entries& entries)
+{
+  map.clear();
+  for (std::size_t i = 0; i < entries.size(); i++)
+  {
+    std::vector<G4String>::const_iterator it = std::lower_bound(names.begin() + 1, names.end(), entries[i].first);
+    if (it != names.end() && *it == entries[i].first) { map[entries[i].second] = it - names.begin(); }
+  }
+}
+
+/// @brief Particles, processes and volumes of the calling thread
+
+void StepDictionary::Collect(Entries& particles, Entries& processes, Entries& volumes)
+{
+  G4ParticleTable::G4PTblDicIterator* particleIterator = G4ParticleTable::GetParticleTable()->GetIterator();
+  particleIterator->reset();
+  while ((*particleIterator)())
+  {
+    G4ParticleDefinition* particle = particleIterator->value();
+    particles.push_back(std::make_pair(particle->GetParticleName(), (const void*)particle));
+
+    G4ProcessManager* pmanager = particle->GetProcessManager();
+    if (!pmanager) { continue; }
+    G4ProcessVector* processList = pmanager->GetProcessList();
+    for (G4int i = 0; i < (G4int)processList->size(); i++)
+    {
+      const G4VProcess* process = (*processList)[i];
+      processes.push_back(std::make_pair(process->GetProcessName(), (const void*)process));
+    }
+  }
+
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  for (std::size_t i = 0; i < store->size(); i++)
+  {
+    const G4LogicalVolume* volume = (*store)[i];
+    volumes.push_back(std::make_pair(volume->GetName(), (const void*)volume));
+  }
+}
+
+/**
+ * @brief Building the name lists from the tables of the master, once per job
+ *
+ * Later runs keep them, so steps.col files of one job share the IDs. Ions created during
+ * the runs are not added, they are written as GenericIon.
+ *
+ **/
+
+void StepDictionary::BuildNames()
+{
+  if (!fParticleNames.empty()) { return; }
+
+  Entries particles, processes, volumes;
+  Collect(particles, processes, volumes);
+  Sort(fParticleNames, particles);
+  Sort(fProcessNames, processes);
+  Sort(fVolumeNames, volumes);
+}
+
+/// @brief Mapping the particles, processes and volumes of this thread to the master IDs
+
+void StepDictionary::Build()
+{
+  Entries particles, processes, volumes;
+  Collect(particles, processes, volumes);
+
+  Assign(fParticleNames, fParticles, particles);
+  Assign(fProcessNames, fProcesses, processes);
+  Assign(fVolumeNames, fVolumes, volumes);
+
+  fWorld = 0;
+  fDetector = 0;
+  for (std::size_t i = 0; i < volumes.size(); i++)
+  {
+    if (volumes[i].first == "World") { fWorld = static_cast<const G4LogicalVolume*>(volumes[i].second); }
+    if (volumes[i].first == "Detector") { fDetector = static_cast<const G4LogicalVolume*>(volumes[i].second); }
+  }
+
+  std::vector<G4String>::const_iterator ion =
+    std::lower_bound(fParticleNames.begin() + 1, fParticleNames.end(), G4String("GenericIon"));
+  fGenericIonID = (ion != fParticleNames.end() && *ion == "GenericIon") ? ion - fParticleNames.begin() : 0;
+
+  fLastParticle = 0;
+  fLastProcess = 0;
+}
+
+/**
+ * @brief Writing the three name lists as a file header
+ *
+ * Every list is a uint32 count followed by length-prefixed (uint32) names.
+ *
+ * @return	False if a write failed
+ *
+ **/
+
+G4bool StepDictionary::Write(std::FILE* file) const
+{
+  const std::vector<G4String>* lists[3] = { &fParticleNames, &fProcessNames, &fVolumeNames };
+
+  G4bool ok = true;
+  for (G4int l = 0; l < 3; l++)
+  {
+    std::uint32_t count = lists[l]->size();
+    ok = ok && std::fwrite(&count, sizeof(count), 1, file) == 1;
+    for (std::size_t i = 0; i < lists[l]->size(); i++)
+    {
+      const G4String& name = (*lists[l])[i];
+      std::uint32_t length = name.size();
+      ok = ok && std::fwrite(&length, sizeof(length), 1, file) == 1
+              && std::fwrite(name.data(), 1, length, file) == length;
+    }
+  }
+  return ok;
+}
+
+/// End of file
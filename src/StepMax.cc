@@ -10,6 +10,11 @@
  **/
 
 #include "StepMax.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
+#include "G4UserLimits.hh"
+
+#include <algorithm>
 
 /// Constructor of Stepmax
 
@@ -36,15 +41,18 @@ void StepMax::SetMaxStep(G4double step)
   fMaxChargedStep = step;
 }
 
-/// Get Physical Interaction Length from post step
+/// Get Physical Interaction Length from post step: limit of the volume, of its region or the global one
 
-G4double StepMax::PostStepGetPhysicalInteractionLength( const G4Track&,
+G4double StepMax::PostStepGetPhysicalInteractionLength( const G4Track& track,
                                                    G4double,
                                                    G4ForceCondition* condition )
 {
   *condition = NotForced; /// condition is set to "Not Forced"
 
-  return fMaxChargedStep;
+  const G4LogicalVolume* volume = track.GetVolume()->GetLogicalVolume();
+  G4UserLimits* limits = volume->GetUserLimits();
+  if (!limits) { limits = volume->GetRegion()->GetUserLimits(); }
+  return limits ? std::min(limits->GetMaxAllowedStep(track), fMaxChargedStep) : fMaxChargedStep;
 }
 
 /// Initializing particle change by post step
@@ -0,0 +1,193 @@
+/**
+ * @file /ECal_MT/src/StepOutputService.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's asynchronous writer of step record blocks.
+ * Workers never touch the file, they only exchange block pointers through lock-free queues.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "StepOutputService.hh"
+#include "StepDictionary.hh"
+
+#include <chrono>
+#include <cstring>
+
+StepOutputService* StepOutputService::fInstance = 0;
+
+/**
+ * @brief Constructor of Step output service
+ *
+ * @param nBlocks 		Number of blocks in the pool (bounds the memory)
+ * @param blockSize 	Number of records in one block
+ *
+ **/
+
+StepOutputService::StepOutputService(std::size_t nBlocks, std::size_t blockSize)
+: fPool(nBlocks), fFree(nBlocks), fFilled(nBlocks), fFile(0), fStop(false), fRunning(false), fFailed(false), fCodecType(kStepCodecRans),
+  fSubmitted(0), fBytesWritten(0), fRawBytes(0), fEncodeNanoseconds(0), fWriteNanoseconds(0),
+  fMaxDepth(0), fStallNanoseconds(0), fStalls(0)
+{
+  for (std::size_t i = 0; i < fPool.size(); i++)
+  {
+    fPool[i].thread = 0;
+    fPool[i].size = 0;
+    fPool[i].records.resize(blockSize);
+    fFree.Push(&fPool[i]);
+  }
+  fInstance = this;
+}
+
+/// @brief Destructor of Step output service
+
+StepOutputService::~StepOutputService()
+{
+  Stop();
+  if (fInstance == this) { fInstance = 0; }
+}
+
+/**
+ * @brief Opening the output file and starting the writer thread
+ *
+ * @param fileName 	Binary step file, the dictionary of the master thread is its header
+ *
+ **/
+
+void StepOutputService::Start(const G4String& fileName)
+{
+  Stop();
+
+  fFileName = fileName;
+  fFile = std::fopen(fFileName.c_str(), "wb");
+  if (!fFile)
+  {
+    G4Exception("StepOutputService::Start()", "ECal002", FatalException,
+                ("Cannot open " + fFileName).c_str());
+    return;
+  }
+
+  StepFileHeader header;
+  std::memcpy(header.magic, "ECALSTP4", sizeof(header.magic));
+  header.recordSize = sizeof(StepRecord);
+  G4bool written = std::fwrite(&header, sizeof(header), 1, fFile) == 1;
+  written = StepDictionary::Instance()->Write(fFile) && written;
+  fFailed = !written;
+
+  fSubmitted = 0;
+  fBytesWritten = std::ftell(fFile);
+  fRawBytes = fBytesWritten.load();
+  fEncodeNanoseconds = 0;
+  fWriteNanoseconds = 0;
+  fMaxDepth = 0;
+  fStallNanoseconds = 0;
+  fStalls = 0;
+  fStop = false;
+  fWriter = std::thread(&StepOutputService::WriterLoop, this);
+  fRunning.store(true, std::memory_order_release);
+}
+
+/// @brief Writing every submitted block, then stopping the writer thread and closing the file
+
+void StepOutputService::Stop()
+{
+  if (!fWriter.joinable()) { return; }
+
+  fRunning.store(false, std::memory_order_release);
+  fStop.store(true, std::memory_order_release);
+  fWriter.join();
+
+  if (std::fclose(fFile) != 0) { fFailed = true; }
+  fFile = 0;
+}
+
+/// @brief Body of the writer thread
+
+void StepOutputService::WriterLoop()
+{
+  for (;;)
+  {
+    G4bool stopping = fStop.load(std::memory_order_acquire); /// read first, so nothing submitted before Stop() is lost
+    G4bool written = false;
+
+    StepBlock* block;
+    while (fFilled.Pop(block))
+    {
+      std::uint64_t depth = fFilled.Size() + 1;
+      std::uint64_t maxDepth = fMaxDepth.load(std::memory_order_relaxed);
+      while (depth > maxDepth && !fMaxDepth.compare_exchange_weak(maxDepth, depth)) {}
+
+      std::chrono::steady_clock::time_point encodeStart = std::chrono::steady_clock::now();
+      StepBlockHeader header;
+      header.thread = block->thread;
+      header.nRecords = block->size;
+      header.codec = fCodec.Encode(block->records.data(), block->size, fCodecType, fPayload);
+      header.size = fPayload.size();
+      std::chrono::steady_clock::time_point encodeEnd = std::chrono::steady_clock::now();
+
+      /// after a failed write the blocks are only given back, the file is not continued
+      if (!fFailed.load(std::memory_order_relaxed) &&
+          (std::fwrite(&header, sizeof(header), 1, fFile) != 1 ||
+           std::fwrite(fPayload.data(), 1, fPayload.size(), fFile) != fPayload.size()))
+      {
+        fFailed.store(true, std::memory_order_release);
+      }
+      std::chrono::steady_clock::time_point writeEnd = std::chrono::steady_clock::now();
+
+      fRawBytes += sizeof(header) + block->size*sizeof(StepRecord);
+      if (!fFailed.load(std::memory_order_relaxed)) { fBytesWritten += sizeof(header) + fPayload.size(); }
+      fEncodeNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(encodeEnd - encodeStart).count();
+      fWriteNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(writeEnd - encodeEnd).count();
+
+      block->size = 0;
+      fFree.Push(block);
+      written = true;
+    }
+
+    if (stopping) { break; }
+    if (!written) { std::this_thread::sleep_for(std::chrono::microseconds(100)); }
+  }
+}
+
+/// @brief Free block for a worker, waits for the writer if the pool is empty
+
+StepBlock* StepOutputService::Acquire()
+{
+  StepBlock* block;
+  if (fFree.Pop(block)) { return block; }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  while (!fFree.Pop(block)) { std::this_thread::yield(); }
+  fStallNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start).count();
+  fStalls++;
+  return block;
+}
+
+/// @brief Handing a filled block to the writer thread
+
+void StepOutputService::Submit(StepBlock* block)
+{
+  while (!fFilled.Push(block)) { std::this_thread::yield(); } /// cannot be full, every block fits in
+  fSubmitted++;
+}
+
+/// @brief Statistics of the run for sizing the pool
+
+void StepOutputService::Report() const
+{
+  G4cout
+    << G4endl
+    << " Step output (" << fFileName << "): "
+    << fSubmitted.load() << " blocks, "
+    << fBytesWritten.load() / (1024.*1024.) << " MB written of "
+    << fRawBytes.load() / (1024.*1024.) << " MB records (codec " << fCodecType << ")" << G4endl
+    << " Writer thread: " << fEncodeNanoseconds.load() * 1e-6 << " ms encoding, "
+    << fWriteNanoseconds.load() * 1e-6 << " ms writing" << G4endl
+    << " Maximum queue depth: " << fMaxDepth.load() << " of " << fPool.size() << " blocks" << G4endl
+    << " Worker stalls: " << fStalls.load() << " (" << fStallNanoseconds.load() * 1e-6 << " ms in total)" << G4endl;
+  if (fFailed.load()) { G4cout << " Writing " << fFileName << " failed (disk full?), the file is incomplete" << G4endl; }
+}
+
+/// End of file
@@ -0,0 +1,54 @@
+/**
+ * @file /ECal_MT/src/StepRecordBuffer.cc
+ * @date 2026/10/16 <creation>
+ *
+ * @section DESCRIPTION
+ *
+ * The Geant4 simulation of ECal's thread local buffer of binary step records.
+ * Records are collected in blocks of the output service, so no lock is taken on the output path.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "StepRecordBuffer.hh"
+
+/**
+ * @brief Constructor of Step record buffer
+ *
+ * @param threadID 	ID of the owner thread (written in the block headers)
+ *
+ **/
+
+StepRecordBuffer::StepRecordBuffer(G4int threadID)
+: fThreadID(threadID < 0 ? 0 : threadID), fBlock(0) /// sequential mode runs as thread -1
+{}
+
+/// @brief Destructor of Step record buffer
+
+StepRecordBuffer::~StepRecordBuffer()
+{
+  Flush();
+}
+
+/// @brief Taking a free block from the output service, false if step records are not written
+
+G4bool StepRecordBuffer::Acquire()
+{
+  if (!IsEnabled()) { return false; }
+
+  fBlock = StepOutputService::Instance()->Acquire();
+  fBlock->thread = fThreadID;
+  fBlock->size = 0;
+  return true;
+}
+
+/// @brief Handing the records collected so far to the writer thread
+
+void StepRecordBuffer::Flush()
+{
+  if (!fBlock) { return; } /// a block is only taken for a record, so it is never empty here
+
+  StepOutputService::Instance()->Submit(fBlock);
+  fBlock = 0;
+}
+
+/// End of file
@@ -10,6 +10,12 @@
  **/
 
 #include "SteppingAction.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4PhysicalConstants.hh"
+#include "GenstepOutput.hh"
+#include "PhysicsList.hh"
+#include "G4EmSaturation.hh"
 
 
 /// Constructor of Stepping action
@@ -17,7 +23,7 @@
 SteppingAction::SteppingAction(EventAction* eventAction)
 : G4UserSteppingAction(),
   fEventAction(eventAction),
-  fLite(false)
+  fDictionary(StepDictionary::Instance())
 {}
 
 /// Destructor of Stepping action
@@ -25,58 +31,103 @@ SteppingAction::SteppingAction(EventAction* eventAction)
 SteppingAction::~SteppingAction()
 {}
 
-/// User Stepping action for collecting datas from steps
+/**
+ * @brief User Stepping action of the runs filling the light table or recording gensteps
+ *
+ * The scoring is done by the sensitive detectors, RunAction installs this action only
+ * for the runs which need it.
+ *
+ **/
 
 void SteppingAction::UserSteppingAction(const G4Step* fStep)
 {
+  FiberLightTable* lightTable = fEventAction->GetRun()->GetLightTable();
+  if (lightTable && fStep->GetTrack()->GetParentID() == 0) { FillLightTable(fStep, lightTable); return; } /// photons of the table
+
+  if (fEventAction->IsLoggingGensteps()) { RecordGenstep(fStep); } /// primaries and stopping tracks too
+}
 
-  G4double edepStep = fStep->GetTotalEnergyDeposit();
-  G4Track * fTrack = fStep->GetTrack();
-  G4int trackID=fTrack->GetTrackID();
-  G4int eID = 0;
-  const G4Event* evt = G4RunManager::GetRunManager()->GetCurrentEvent();
-  if(evt) eID = evt->GetEventID();
-
-  G4double postTime = fStep->GetPostStepPoint()->GetLocalTime();
-
-  if(fTrack->GetTrackStatus()!=fAlive) { return; } /// check if it is alive
-
-  G4ParticleDefinition *particle=fTrack->GetDefinition();
-
-  G4VPhysicalVolume* prevolume  =
-    fStep->GetPreStepPoint()->GetTouchableHandle()->GetVolume();
-  G4VPhysicalVolume* postvolume  =
-    fStep->GetPostStepPoint()->GetTouchableHandle()->GetVolume();
-
-  G4double preX = fStep->GetPreStepPoint()->GetPosition().x();
-  G4double preY = fStep->GetPreStepPoint()->GetPosition().y();
-  G4double preZ  = fStep->GetPreStepPoint()->GetPosition().z();
-  G4double prekinE  = fStep->GetPreStepPoint()->GetKineticEnergy();
-
-  G4double postX = fStep->GetPostStepPoint()->GetPosition().x();
-  G4double postY = fStep->GetPostStepPoint()->GetPosition().y();
-  G4double postZ = fStep->GetPostStepPoint()->GetPosition().z();
-  G4double postkinE  = fStep->GetPostStepPoint()->GetKineticEnergy();
-
-  G4String particleName = particle->GetParticleName();
-  G4String preName=prevolume->GetName();
-  G4String postName=postvolume->GetName();
-  G4String procN;
-
-  if(fTrack->GetCreatorProcess()!=0) {
-    procN = fTrack->GetCreatorProcess()->GetProcessName();
-      if (postName == "World") {
-        fTrack->SetTrackStatus(fStopAndKill);
-      }
-	if((edepStep!=0)||(postName == "Detector")){
-	G4cout << "CalDat " << particleName << " " << procN << " " << trackID << " " << edepStep / MeV << " "
-             << eID << " " << preX / cm << " " << preY / cm << " " << preZ / cm
-             << " " << postX / cm << " " << postY / cm << " " << postZ / cm << " " << preName << " " << postName << " "
-             << postTime / ns << G4endl;
-		}
-    }
+/// @brief The run fills the light table or records gensteps, read at the start of every run
 
+G4bool SteppingAction::IsNeeded(const DetectorConstruction* detector)
+{
+  return detector->NeedsFiberLightTable() || (GenstepOutput::Instance() && GenstepOutput::Instance()->IsRunning());
 }
 
-/// End of file
+/**
+ * @brief Counting a primary photon of the run filling the light table
+ *
+ * Emitted at its first step, detected at its step in the Detector (where DetectorSD kills it).
+ * The photons start at time 0 in the fiber at the origin of the table.
+ *
+ **/
+
+void SteppingAction::FillLightTable(const G4Step* step, FiberLightTable* table)
+{
+  const G4Track* track = step->GetTrack();
+  G4int bin = table->GetBin(track->GetVertexPosition() - table->GetOrigin(), track->GetVertexMomentumDirection());
+  if (track->GetCurrentStepNumber() == 1) { table->AddEmitted(bin); }
+
+  const G4LogicalVolume* preLog = step->GetPreStepPoint()->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
+  if (preLog == fDictionary->GetDetector()) { table->AddDetected(bin, step->GetPreStepPoint()->GetGlobalTime()); }
+}
 
+/**
+ * @brief Recording the inputs of the scintillation and Cerenkov photons of a charged step
+ *
+ * Every charged step in a material with optical properties is kept, the photons of the
+ * step are regenerated from the record by GenstepGenerator in a replay run. Where G4Scintillation
+ * has G4EmSaturation (Birks' law), the visible energy is recorded, so the replay, which
+ * scintillates yield*edep, gives the light of the original shower.
+ *
+ **/
+
+void SteppingAction::RecordGenstep(const G4Step* step)
+{
+  G4double charge = step->GetTrack()->GetDynamicParticle()->GetCharge();
+  if (charge == 0 || step->GetStepLength() <= 0) { return; }
+
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  const G4StepPoint* post = step->GetPostStepPoint();
+  if (!IsOpticalMaterial(pre->GetMaterial())) { return; }
+
+  const G4ThreeVector& prePos = pre->GetPosition();
+  G4ThreeVector delta = post->GetPosition() - prePos;
+
+  GenstepRecord genstep;
+  genstep.x = prePos.x() / mm;
+  genstep.y = prePos.y() / mm;
+  genstep.z = prePos.z() / mm;
+  genstep.dx = delta.x() / mm;
+  genstep.dy = delta.y() / mm;
+  genstep.dz = delta.z() / mm;
+  genstep.time = pre->GetGlobalTime() / ns;
+  genstep.deltaTime = (post->GetGlobalTime() - pre->GetGlobalTime()) / ns;
+  genstep.charge = charge / eplus;
+  genstep.preBeta = pre->GetBeta();
+  genstep.postBeta = post->GetBeta();
+  /// the energy the scintillation of this thread used: visible (Birks) if saturation is attached
+  const G4Scintillation* scintillation = PhysicsList::GetScintillationProcess();
+  G4EmSaturation* saturation = scintillation ? scintillation->GetSaturation() : 0;
+  genstep.edep = (saturation ? saturation->VisibleEnergyDepositionAtAStep(step)
+                             : step->GetTotalEnergyDeposit()) / MeV;
+  genstep.material = pre->GetMaterial()->GetIndex();
+  fEventAction->AddGenstep(genstep);
+}
+
+/// @brief Material with a refractive index or a scintillation yield, looked up once per material
+
+G4bool SteppingAction::IsOpticalMaterial(const G4Material* material)
+{
+  std::size_t index = material->GetIndex();
+  if (index >= fOpticalMaterial.size()) { fOpticalMaterial.resize(index + 1, -1); }
+  if (fOpticalMaterial[index] < 0)
+  {
+    G4MaterialPropertiesTable* table = material->GetMaterialPropertiesTable();
+    fOpticalMaterial[index] = (table && (table->GetProperty("RINDEX")
+                                         || table->ConstPropertyExists("SCINTILLATIONYIELD"))) ? 1 : 0;
+  }
+  return fOpticalMaterial[index] > 0;
+}
+
+/// End of file
@@ -0,0 +1,126 @@
+/**
+ * @file /ECal_MT/src/TrackKiller.cc
+ * @date 2026/10/16 <creation>
+ * 
+ * @section DESCRIPTION
+ * 
+ * The Geant4 simulation of ECal's TrackKiller source code for killing slow and late tracks per region.
+ * Latest updates of project can be found in README file.
+ **/
+
+#include "TrackKiller.hh"
+#include "Run.hh"
+#include "G4RunManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4Neutron.hh"
+#include "G4Gamma.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4VTouchable.hh"
+
+/**
+ * @brief Constructor of Track killer
+ *
+ * @param limits 	Owner of the thresholds
+ * @param detector 	Owner of the readout window
+ * @param fVersion 	Version of the thresholds in fRegions, -1: not read yet
+ *
+ **/
+
+TrackKiller::TrackKiller(const RegionLimits* limits, const DetectorConstruction* detector,
+                         const G4String& processName)
+ : G4VDiscreteProcess(processName), fLimits(limits), fDetector(detector),
+   fOpticalPhoton(G4OpticalPhoton::Definition()), fVersion(-1), fAll(0)
+{
+}
+
+/// Destructor of Track killer
+
+TrackKiller::~TrackKiller() { }
+
+/// Category of a particle: neutron, nuclear fragment or gamma
+
+G4int TrackKiller::Category(const G4ParticleDefinition* particle)
+{
+  if (particle == G4Neutron::Definition()) { return kKillNeutron; }
+  if (particle == G4Gamma::Definition()) { return kKillGamma; }
+  if (particle->GetParticleType() == "nucleus") { return kKillFragment; }
+  return -1;
+}
+
+/// Checking if particle is applicable or not: all of them, optical photons only with a readout window
+
+G4bool TrackKiller::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return &particle != fOpticalPhoton || fDetector->GetTimeWindow() > 0;
+}
+
+/// Thresholds of a region, read again after every change of the commands
+
+const KillerThreshold* TrackKiller::Find(const G4Region* region, G4int category)
+{
+  if (fVersion != fLimits->GetKillerVersion())
+  {
+    fVersion = fLimits->GetKillerVersion();
+    fAll = 0;
+    fRegions.clear();
+    const std::vector<RegionKiller>& killers = fLimits->GetKillers();
+    for (std::size_t i = 0; i < killers.size(); i++)
+    {
+      if (killers[i].region == "all") { fAll = &killers[i]; continue; }
+      const G4Region* target = G4RegionStore::GetInstance()->GetRegion(killers[i].region, false);
+      if (target) { fRegions.push_back(std::make_pair(target, &killers[i])); }
+    }
+  }
+
+  for (std::size_t i = 0; i < fRegions.size(); i++)
+  {
+    if (fRegions[i].first == region) { return &fRegions[i].second->threshold[category]; }
+  }
+  return fAll ? &fAll->threshold[category] : 0;
+}
+
+/// Get Physical Interaction Length from post step: 0 if the track escaped, is late or is below or past the thresholds
+
+G4double TrackKiller::PostStepGetPhysicalInteractionLength( const G4Track& track,
+                                                       G4double,
+                                                       G4ForceCondition* condition )
+{
+  *condition = NotForced;
+
+  if (IsEscaped(track) || IsLate(track)) { return 0.; }
+
+  G4int category = Category(track.GetDefinition());
+  if (category < 0) { return DBL_MAX; }
+  const KillerThreshold* threshold = Find(track.GetVolume()->GetLogicalVolume()->GetRegion(), category);
+  if (threshold && ((threshold->energy > 0 && track.GetKineticEnergy() < threshold->energy)
+                    || (threshold->time > 0 && track.GetGlobalTime() > threshold->time)))
+  {
+    return 0.;
+  }
+  return DBL_MAX;
+}
+
+/// Killing the track and counting it in the run of the thread
+
+G4VParticleChange* TrackKiller::PostStepDoIt(const G4Track& aTrack, const G4Step&)
+{
+  aParticleChange.Initialize(aTrack);
+  aParticleChange.ProposeTrackStatus(fStopAndKill);
+  if (IsEscaped(aTrack)) { return &aParticleChange; } /// the energy leaves the calorimeter
+
+  Run* run = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+  if (IsLate(aTrack))
+  {
+    if (run) { run->CountLate(aTrack.GetDefinition() == fOpticalPhoton, aTrack.GetKineticEnergy()); }
+    return &aParticleChange;
+  }
+
+  G4int category = Category(aTrack.GetDefinition());
+  if (category == kKillFragment) { aParticleChange.ProposeLocalEnergyDeposit(aTrack.GetKineticEnergy()); }
+  if (run) { run->CountKilled(category, aTrack.GetKineticEnergy()); }
+  return &aParticleChange;
+}
+
+/// End of file